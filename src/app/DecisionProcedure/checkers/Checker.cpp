@@ -2,12 +2,17 @@
 // Created by Raph on 02/02/2016.
 //
 
+#include <algorithm>
 #include "Checker.h"
 #include "../../Frontend/predlib.h"
 #include "../../Frontend/untyped.h"
 #include "../../Frontend/symboltable.h"
 #include "../containers/VarToTrackMap.hh"
 #include "../environment.hh"
+#include "../utils/FormulaBundle.h"
+#include "../utils/LiveStats.h"
+#include "../utils/Tracer.h"
+#include "../utils/TrackOrdering.h"
 
 #include "../visitors/transformers/AntiPrenexer.h"
 #include "../visitors/transformers/BooleanUnfolder.h"
@@ -18,6 +23,7 @@
 #include "../visitors/transformers/BaseAutomataMerger.h"
 #include "../visitors/transformers/ExistentialPrenexer.h"
 #include "../visitors/transformers/ShuffleVisitor.h"
+#include "../visitors/transformers/ConjunctClusterer.h"
 #include "../visitors/transformers/ContinuationSwitcher.h"
 #include "../visitors/transformers/Derestricter.h"
 #include "../visitors/restricters/UniversalQuantifierRemover.h"
@@ -84,9 +90,28 @@ void initializeVarMap(ASTForm* formula) {
 #   endif
 
     IdentList *vars = ident_union(&free, &bound);
-    if (vars != nullptr) {
-        varMap.initializeFromList(vars);
+    if (vars == nullptr) {
+        return;
     }
+
+#   if (OPT_ORDER_TRACKS == true)
+    bool reorder = true;
+#   else
+    bool reorder = (options.trackOrder != nullptr);
+#   endif
+    if (reorder) {
+        TrackOrdering ordering(formula);
+        size_t bandwidth = ordering.Bandwidth(vars);
+        ordering.Order(vars, options.trackOrder);
+        if (options.printProgress) {
+            std::cout << "[*] Track order:";
+            for (auto it = vars->begin(); it != vars->end(); ++it) {
+                std::cout << " " << symbolTable.lookupSymbol(*it);
+            }
+            std::cout << " (bandwidth " << bandwidth << " -> " << ordering.Bandwidth(vars) << ")\n";
+        }
+    }
+    varMap.initializeFromList(vars, reorder);
     delete vars;
 }
 
@@ -253,7 +278,7 @@ void Checker::CloseUngroundFormula() {
                 this->_rootRestriction = static_cast<ASTForm*>(this->_rootRestriction->accept(defirstorderer));
 #               endif
                 this->_rootRestriction->is_restriction = true;
-                FixpointDetagger detagger(options.fixLimit);
+                FixpointDetagger detagger(options.fixLimit, options.adaptiveFixLimit);
                 this->_rootRestriction->accept(detagger);
                 break;
         }
@@ -266,10 +291,13 @@ void Checker::CloseUngroundFormula() {
  * some of the tags in order to transform them into the subautomata. Finally everything is restricted to second order.
  */
 void Checker::PreprocessFormula() {
+    Tracer::Scope traceScope("preprocess", "phase");
+    LiveStats::EnterPhase("preprocess");
     this->_startTimer(timer_preprocess);
     // Flattening of the formula
     PredicateUnfolder predicateUnfolder;
     this->_monaAST->formula = static_cast<ASTForm *>((this->_monaAST->formula)->accept(predicateUnfolder));
+    this->_PreprocessSharedPredicates(predicateUnfolder.sharedPredicates);
 
     if (options.dump) {
         G_DEBUG_FORMULA_AFTER_PHASE("Predicate Unfolding");
@@ -282,8 +310,10 @@ void Checker::PreprocessFormula() {
             OccuringVariableDecorator decorator; \
             this->_monaAST->formula->accept(decorator); \
         } \
+        std::uint64_t filter##_traceStart = Tracer::Now(); \
         filter filter##_visitor;    \
         this->_monaAST->formula = static_cast<ASTForm *>(this->_monaAST->formula->accept(filter##_visitor));    \
+        Tracer::Complete(#filter, "preprocess", filter##_traceStart); \
         if(options.dump) {    \
             G_DEBUG_FORMULA_AFTER_PHASE(#filter);    \
             (this->_monaAST->formula)->dump();    std::cout << "\n";    \
@@ -349,10 +379,18 @@ void Checker::PreprocessFormula() {
         InverseFixpointDetagger inverseDetagger(options.inverseFixLimit);
         (this->_monaAST->formula)->accept(inverseDetagger);
     } else {
-        FixpointDetagger detagger(options.fixLimit);
+        FixpointDetagger detagger(options.fixLimit, options.adaptiveFixLimit);
         (this->_monaAST->formula)->accept(detagger);
     }
 
+#   if (OPT_CLUSTER_CONJUNCTS == true)
+    ConjunctClusterer clusterer;
+    this->_monaAST->formula = static_cast<ASTForm*>(this->_monaAST->formula->accept(clusterer));
+#   if (MEASURE_AUTOMATA_METRICS == true)
+    std::cout << "Clusters: " << clusterer.clusters << "\n";
+#   endif
+#   endif
+
     if(options.graphvizDAG) {
         std::string dotFileName(inputFileName);
         dotFileName += ".dot";
@@ -367,7 +405,105 @@ void Checker::PreprocessFormula() {
 #   endif
 
     this->_stopTimer(timer_preprocess, "Preprocess");
+    this->_InitializeTracks();
+}
 
+/**
+ * Preprocesses the bodies of the predicates, whose call sites were kept during the unfolding. Each body goes through
+ * the same phases as the formula (except of tags) only once for all of its call sites. Nested shared predicates are
+ * preprocessed first, so the fixpoint numbers of their calls are known during the detagging of the body.
+ *
+ * @param[in] predicates:  predicates of the kept call sites
+ */
+void Checker::_PreprocessSharedPredicates(std::list<PredLibEntry*>& predicates) {
+    for(PredLibEntry* called : predicates) {
+        if(called->sharedAst != nullptr) {
+            continue;
+        }
+
+        PredicateUnfolder predicateUnfolder;
+        ASTForm* body = static_cast<ASTForm*>(called->ast->clone()->accept(predicateUnfolder));
+        this->_PreprocessSharedPredicates(predicateUnfolder.sharedPredicates);
+
+#define CALL_FILTER(filter) \
+        if(!strcmp(#filter, "FullAntiPrenexer")) { \
+            OccuringVariableDecorator decorator; \
+            body->accept(decorator); \
+        } \
+        filter filter##_visitor;    \
+        body = static_cast<ASTForm *>(body->accept(filter##_visitor));
+    FILTER_LIST(CALL_FILTER)
+#undef CALL_FILTER
+
+        if (!options.monaWalk) {
+            SecondOrderRestricter restricter;
+            body = static_cast<ASTForm*>(body->accept(restricter));
+
+            QuantificationMerger quantificationMerger;
+            body = static_cast<ASTForm*>(body->accept(quantificationMerger));
+        }
+
+        std::list<size_t> tags;
+        Tagger tagger(tags);
+        body->accept(tagger);
+        if(options.inverseFixLimit != -1) {
+            InverseFixpointDetagger inverseDetagger(options.inverseFixLimit);
+            body->accept(inverseDetagger);
+        } else {
+            // Base automaton of the body is reused by each of its call sites
+            size_t references = std::count(predicates.begin(), predicates.end(), called);
+            FixpointDetagger detagger(options.fixLimit, options.adaptiveFixLimit, references);
+            body->accept(detagger);
+        }
+#       if (OPT_CLUSTER_CONJUNCTS == true)
+        ConjunctClusterer clusterer;
+        body = static_cast<ASTForm*>(body->accept(clusterer));
+#       endif
+
+        if (options.dump) {
+            std::cout << "\n[*] Shared body of predicate '" << symbolTable.lookupSymbol(called->name) << "':\n";
+            body->dump();
+            std::cout << "\n";
+        }
+        called->sharedAst = body;
+    }
+}
+
+/**
+ * Writes the preprocessed formula into the bundle at @p path, so the later runs can skip the parsing, closing and
+ * preprocessing of the formula
+ *
+ * @param[in] path:     path of the written bundle
+ * @return  true if the bundle was written
+ */
+bool Checker::CompileFormula(const char* path) {
+    assert(this->_monaAST != nullptr);
+    return FormulaBundle::Compile(path, this->_monaAST, this->_rootRestriction, this->_isGround);
+}
+
+/**
+ * Loads the preprocessed formula from the bundle given as input file instead of LoadFormulaFromFile(),
+ * CloseUngroundFormula() and PreprocessFormula()
+ *
+ * @return  true if the bundle was loaded
+ */
+bool Checker::LoadFormulaFromBundle() {
+    this->_monaAST = FormulaBundle::Load(inputFileName, this->_rootRestriction, this->_isGround);
+    if(this->_monaAST == nullptr) {
+        return false;
+    }
+    lastPosVar = this->_monaAST->lastPosVar;
+    allPosVar = this->_monaAST->allPosVar;
+    // Tracks were restored from the bundle
+    AST::temporalMapping.resize(symbolTable.noIdents);
+    std::fill(AST::temporalMapping.begin(), AST::temporalMapping.end(), 0);
+    return true;
+}
+
+/**
+ * Assigns the tracks to the variables of the preprocessed formula
+ */
+void Checker::_InitializeTracks() {
     // Table or BDD tracks are reordered
     initializeVarMap(this->_monaAST->formula);
     AST::temporalMapping.resize(symbolTable.noIdents);
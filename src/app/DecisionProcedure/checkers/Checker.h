@@ -8,7 +8,9 @@
 #include "../../Frontend/ast.h"
 #include "../../Frontend/timer.h"
 #include "../environment.hh"
+#include <list>
 
+class PredLibEntry;
 using TimerType = Timer;
 
 /*******************************
@@ -56,6 +58,8 @@ public:
     void LoadFormulaFromFile();
     void CloseUngroundFormula();
     void PreprocessFormula();
+    bool CompileFormula(const char*);
+    bool LoadFormulaFromBundle();
     void CreateAutomataSizeEstimations();
     virtual void ConstructAutomaton() = 0;
     virtual void Decide() = 0;
@@ -70,6 +74,8 @@ protected:
 	bool _terminatedBySignal = false;
 
 	// <<< PRIVATE METHODS >>>
+	virtual void _InitializeTracks();
+	void _PreprocessSharedPredicates(std::list<PredLibEntry*>&);
 	void _startTimer(Timer& t);
 	void _stopTimer(Timer& t, char* s);
 	template<class ZeroOrderQuantifier, class FirstOrderQuantifier, class SecondOrderQuantifier>
@@ -0,0 +1,322 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Incremental checking of the related formulae
+ *****************************************************************************/
+
+#include <iostream>
+#include "IncrementalChecker.h"
+#include "../containers/TermReclaimer.h"
+#include "../containers/VarToTrackMap.hh"
+#include "../containers/Workshops.h"
+#include "../utils/LiveStats.h"
+#include "../utils/Tracer.h"
+#include "../../Frontend/ast_visitor.h"
+#include "../../Frontend/env.h"
+#include "../../Frontend/predlib.h"
+#include "../../Frontend/symboltable.h"
+
+extern PredicateLib predicateLib;
+extern SymbolTable symbolTable;
+extern VarToTrackMap varMap;
+extern Options options;
+extern Ident allPosVar;
+
+/**
+ * Forgets the automata constructed for the nodes of the formula
+ */
+class AutomataForgetter : public VoidVisitor {
+public:
+    AutomataForgetter() : VoidVisitor(Traverse::PreOrder) {}
+
+    void visit(ASTForm* form) { form->sfa = nullptr; }
+    void visit(ASTTerm* term) {}
+    void visit(ASTUniv* univ) {}
+};
+
+IncrementalChecker::~IncrementalChecker() {
+    TermReclaimer::retainedRoots.clear();
+    for(SymbolicAutomaton* root : this->_roots) {
+        root->DecReferences();
+    }
+#   if (OPT_USE_BOOST_POOL_FOR_ALLOC == false)
+    for(Symbol* symbol : this->_retiredZeroSymbols) {
+        delete symbol;
+    }
+#   endif
+}
+
+/**
+ * Opens the new frame of assertions, that are removed by the matching Pop()
+ */
+void IncrementalChecker::Push() {
+    this->_frames.push_back(this->_assertions.size());
+}
+
+/**
+ * Asserts the @p formula in the current frame. The formula has to be typed against the symbol table of the loaded
+ * file and is never modified, every check decides its own copy.
+ *
+ * @param[in] formula:  asserted formula
+ */
+void IncrementalChecker::Assert(ASTForm* formula) {
+    assert(formula != nullptr);
+    this->_assertions.push_back(formula);
+}
+
+/**
+ * Removes the assertions of the current frame. Automata constructed for them are kept, so they can be shared by
+ * the later checks.
+ */
+void IncrementalChecker::Pop() {
+    assert(!this->_frames.empty());
+    this->_assertions.resize(this->_frames.back());
+    this->_frames.pop_back();
+}
+
+/**
+ * Decides the conjunction of all of the asserted formulae. Unless the conjunction has to be closed by quantifiers,
+ * its conjuncts are preprocessed separately and only once, and the preprocessed conjuncts are joined by the symbolic
+ * products.
+ *
+ * @return  decision of the conjunction
+ */
+Decision IncrementalChecker::Check() {
+    assert(this->_monaAST != nullptr);
+    Tracer::Scope traceScope("check", "incremental");
+
+    ASTForm* conjunction = new ASTForm_True(Pos());
+    for(ASTForm* assertion : this->_assertions) {
+        conjunction = new ASTForm_And(conjunction, assertion->clone(), Pos());
+    }
+    // Note: formulae of the previous checks are not freed, as they are the keys of DAG of automata
+    this->_monaAST->formula = conjunction;
+    this->_rootRestriction = nullptr;
+    this->_terminatedBySignal = false;
+
+    if(this->_assertions.empty() || this->_IsClosedByQuantifiers()) {
+        this->CloseUngroundFormula();
+        this->PreprocessFormula();
+    } else {
+        // Only the restriction of the free variables is created, the copy of the conjunction is not used
+        this->CloseUngroundFormula();
+        delete conjunction;
+        this->_monaAST->formula = this->_ConjoinPreprocessed();
+    }
+    this->ConstructAutomaton();
+
+    LiveStats::EnterPhase("decision");
+    Decision decision = this->_DecideCore(this->Run());
+
+    if(this->_terminatedBySignal) {
+        // The stopped check may have left partial results in the shared automata, so they are not shared anymore
+        std::cout << "[!] Check was stopped, automata of the previous checks will not be shared\n";
+        this->_DropSharedState();
+        this->_automaton->IncReferences();
+        this->_automaton->DecReferences();
+        this->_automaton = nullptr;
+        return decision;
+    }
+    this->_automaton->IncReferences();
+    this->_roots.push_back(this->_automaton);
+    TermReclaimer::retainedRoots.push_back(this->_automaton);
+    this->_automaton = nullptr;
+    return decision;
+}
+
+/**
+ * @return  true if the conjunction of the assertions is closed by the quantifiers over its free variables, so its
+ *   conjuncts cannot be preprocessed separately
+ */
+bool IncrementalChecker::_IsClosedByQuantifiers() {
+    if(options.test == TestType::EVERYTHING) {
+        return false;
+    }
+    for(ASTForm* assertion : this->_assertions) {
+        IdentList free, bound;
+        assertion->freeVars(&free, &bound);
+        for(auto it = free.begin(); it != free.end(); ++it) {
+            if(*it != allPosVar) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Preprocesses the copy of the @p assertion, unless it was already preprocessed. The preprocessed formula is kept
+ * with its automata, so the later checks neither preprocess it again nor create new fresh variables for it.
+ *
+ * @param[in] assertion:  asserted formula
+ * @return  preprocessed copy of the @p assertion
+ */
+ASTForm* IncrementalChecker::_PreprocessAssertion(ASTForm* assertion) {
+    auto it = this->_preprocessed.find(assertion);
+    if(it != this->_preprocessed.end()) {
+        return it->second;
+    }
+
+    // Tracks are assigned to the new variables at the end of the preprocessing
+    this->_monaAST->formula = assertion->clone();
+    this->PreprocessFormula();
+    ASTForm* preprocessed = this->_monaAST->formula;
+    this->_monaAST->formula = nullptr;
+
+    this->_preprocessed.insert(std::make_pair(assertion, preprocessed));
+    return preprocessed;
+}
+
+/**
+ * Joins the preprocessed assertions by the left-leaning chain of symbolic products, the tags and measures of the
+ * new nodes are computed the same way the ConjunctClusterer does.
+ *
+ * @return  chain of conjunctions of the preprocessed assertions
+ */
+ASTForm* IncrementalChecker::_ConjoinPreprocessed() {
+    assert(!this->_assertions.empty());
+    // All of the assertions are preprocessed first, so the tracks are assigned before any automaton is constructed
+    std::vector<ASTForm*> conjuncts;
+    for(ASTForm* assertion : this->_assertions) {
+        conjuncts.push_back(this->_PreprocessAssertion(assertion));
+    }
+
+    ASTForm* result = conjuncts.front();
+    for(auto it = conjuncts.begin() + 1; it != conjuncts.end(); ++it) {
+        ASTForm_And* conjunction = new ASTForm_And(result, *it, Pos());
+        conjunction->fixpoint_number = std::max(result->fixpoint_number, (*it)->fixpoint_number);
+        conjunction->height = std::max(result->height, (*it)->height) + 1;
+        conjunction->dag_height = std::max(result->dag_height, (*it)->dag_height) + 1;
+        conjunction->size = result->size + (*it)->size + 1;
+        conjunction->tag = 1;
+        conjunction->is_cluster_product = true;
+        result = conjunction;
+    }
+    return result;
+}
+
+/**
+ * Decides the formula of the loaded file in conjunction with each of its verify declarations
+ * (verify "title" formula;) in the separate frames. Without verify declarations, only the formula is decided.
+ */
+void IncrementalChecker::RunVerifyQueries() {
+    assert(this->_monaAST != nullptr);
+    DequeGC<ASTForm*>& queries = this->_monaAST->verifyformlist;
+    ASTForm* formula = this->_monaAST->formula;
+
+    // Tracks are assigned to variables of all of the queries at once, so they are not reassigned between the checks
+    this->_MapVariables(formula);
+    for(size_t i = 0; i < queries.size(); ++i) {
+        this->_MapVariables(queries.get(i));
+    }
+    // Fresh variables of the preprocessing are mapped as well, unless the queries are closed by quantifiers
+    if(options.test == TestType::EVERYTHING) {
+        this->_PreprocessAssertion(formula);
+        for(size_t i = 0; i < queries.size(); ++i) {
+            this->_PreprocessAssertion(queries.get(i));
+        }
+    }
+
+    this->Assert(formula);
+    if(queries.size() == 0) {
+        std::cout << "[!] Formula is ";
+        this->_PrintDecision(this->Check());
+        std::cout << "\n";
+        return;
+    }
+    for(size_t i = 0; i < queries.size(); ++i) {
+        std::cout << "\n[*] Checking '" << this->_monaAST->verifytitlelist.get(i) << "'\n";
+        unsigned int dagHits = SymbolicAutomaton::dagNodeCache->GetHits();
+#       if (OPT_RECLAIM_DEAD_TERMS == true)
+        size_t reclaimed = TermReclaimer::reclaimed;
+#       endif
+        this->Push();
+        this->Assert(queries.get(i));
+        Decision decision = this->Check();
+        this->Pop();
+        std::cout << "[!] Query '" << this->_monaAST->verifytitlelist.get(i) << "' is ";
+        this->_PrintDecision(decision);
+        std::cout << " (DAG hits: " << (SymbolicAutomaton::dagNodeCache->GetHits() - dagHits);
+#       if (OPT_RECLAIM_DEAD_TERMS == true)
+        std::cout << ", reclaimed terms: " << (TermReclaimer::reclaimed - reclaimed);
+#       endif
+        std::cout << ")\n";
+    }
+}
+
+/**
+ * Adds the variables of the @p formula to the variables, that will be assigned to tracks
+ *
+ * @param[in] formula:  formula with new variables
+ */
+void IncrementalChecker::_MapVariables(ASTForm* formula) {
+    IdentList free, bound;
+    formula->freeVars(&free, &bound);
+    for(auto it = free.begin(); it != free.end(); ++it) {
+        this->_mappedVars.insert(*it);
+    }
+    for(auto it = bound.begin(); it != bound.end(); ++it) {
+        this->_mappedVars.insert(*it);
+    }
+}
+
+/**
+ * Assigns the tracks only once, unless the preprocessed formula brings some new variable. Then the automata of
+ * the previous checks are built over the different tracks and cannot be shared anymore.
+ */
+void IncrementalChecker::_InitializeTracks() {
+    size_t mapped = this->_mappedVars.size();
+    this->_MapVariables(this->_monaAST->formula);
+
+    if(!this->_tracksInitialized || mapped != this->_mappedVars.size()) {
+        if(!this->_roots.empty()) {
+            std::cout << "[!] Check introduced new variables, automata of the previous checks will not be shared\n";
+            this->_DropSharedState();
+        }
+        IdentList vars;
+        for(Ident var : this->_mappedVars) {
+            vars.push_back(var);
+        }
+        varMap.clear();
+        varMap.initializeFromList(&vars);
+        this->_tracksInitialized = true;
+    }
+    AST::temporalMapping.resize(symbolTable.noIdents);
+    std::fill(AST::temporalMapping.begin(), AST::temporalMapping.end(), 0);
+}
+
+/**
+ * Forgets the automata of the previous checks, so new automata are constructed over the new tracks. The old ones
+ * stay alive until the checker is destroyed.
+ */
+void IncrementalChecker::_DropSharedState() {
+    SymbolicAutomaton::dagNodeCache->clear();
+    SymbolicAutomaton::dagNegNodeCache->clear();
+    TermReclaimer::retainedRoots.clear();
+    // Shared bodies of predicates are constructed again over the new tracks
+    AutomataForgetter forgetter;
+    for(auto& preprocessed : this->_preprocessed) {
+        preprocessed.second->accept(forgetter);
+    }
+    for(PredLibEntry* pred = predicateLib.first(); pred != nullptr; pred = predicateLib.next()) {
+        if(pred->sharedAst != nullptr) {
+            pred->sharedAst->accept(forgetter);
+        }
+    }
+    // Zero symbol is created for the length of the tracks, the old one is freed together with the old automata
+    if(Workshops::SymbolWorkshop::_zeroSymbol != nullptr) {
+        this->_retiredZeroSymbols.push_back(Workshops::SymbolWorkshop::_zeroSymbol);
+        Workshops::SymbolWorkshop::_zeroSymbol = nullptr;
+    }
+}
@@ -0,0 +1,67 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: IncrementalChecker.h
+ *  Description:
+ *      Incremental checking of the related formulae through the stack of
+ *      assertions (push, assert, check, pop). Every check decides the
+ *      conjunction of the asserted formulae; automata of the previous checks
+ *      are kept alive, so the subformulae shared with them are found in the
+ *      DAG of automata together with their base automata, workshops and
+ *      result and subsumption caches. Only the new subformulae are built
+ *      and computed from the scratch. Each asserted formula is preprocessed
+ *      only once, so the fresh variables of the preprocessing do not change
+ *      the tracks between the checks.
+ *****************************************************************************/
+
+#ifndef WSKS_INCREMENTALCHECKER_H
+#define WSKS_INCREMENTALCHECKER_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include "SymbolicChecker.h"
+
+class IncrementalChecker : public SymbolicChecker {
+public:
+    // <<< PUBLIC CONSTRUCTORS >>>
+    IncrementalChecker() : SymbolicChecker() {}
+    ~IncrementalChecker();
+
+    // <<< PUBLIC API >>>
+    void Push();
+    void Assert(ASTForm*);
+    Decision Check();
+    void Pop();
+    void RunVerifyQueries();
+
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    std::vector<ASTForm*> _assertions;          // < Asserted formulae (never preprocessed, checks work on copies)
+    std::map<ASTForm*, ASTForm*> _preprocessed; // < Preprocessed copies of the asserted formulae
+    std::vector<size_t> _frames;                // < Number of the assertions at the time of pushes
+    std::vector<SymbolicAutomaton*> _roots;     // < Roots of the previous checks, keeping the shared automata alive
+    std::set<Ident> _mappedVars;                // < Variables the tracks were assigned to
+    std::vector<Symbol*> _retiredZeroSymbols;   // < Zero symbols of the dropped tracks, used by the old automata
+    bool _tracksInitialized = false;
+
+    // <<< PRIVATE METHODS >>>
+    virtual void _InitializeTracks();
+    void _MapVariables(ASTForm*);
+    bool _IsClosedByQuantifiers();
+    ASTForm* _PreprocessAssertion(ASTForm*);
+    ASTForm* _ConjoinPreprocessed();
+    void _DropSharedState();
+};
+
+#endif //WSKS_INCREMENTALCHECKER_H
@@ -9,15 +9,25 @@
 #include <csignal>
 #include "SymbolicChecker.h"
 #include "../containers/Term.h"
+#include "../containers/TermReclaimer.h"
 #include "../containers/Workshops.h"
 #include "../environment.hh"
+#include "../utils/LiveStats.h"
+#include "../utils/MemoryAccounting.h"
+#include "../utils/ProbePool.h"
+#include "../utils/ResourceGovernor.h"
+#include "../utils/Tracer.h"
 #include "../../Frontend/timer.h"
+#include "../../Frontend/codetable.h"
 #include "../../Frontend/env.h"
+#include "../../Frontend/symboltable.h"
 #include "../visitors/transformers/Derestricter.h"
 
 extern Timer timer_conversion, timer_mona, timer_base, timer_automaton, timer_preprocess, timer_closure, timer_parse;
 extern Ident lastPosVar, allPosVar;
 extern Options options;
+extern SymbolTable symbolTable;
+extern CodeTable *codeTable;
 extern char *inputFileName;
 
 SymbolicChecker::~SymbolicChecker() {
@@ -30,6 +40,10 @@ SymbolicChecker::~SymbolicChecker() {
 void SymbolicChecker::ConstructAutomaton() {
     assert(this->_monaAST != nullptr);
 
+    Tracer::Scope traceScope("SA creation", "phase");
+    LiveStats::EnterPhase("SA creation");
+    SymbolicAutomaton::dagNodeCache->SetCategory(MemoryCategory::DAG_CACHE);
+    SymbolicAutomaton::dagNegNodeCache->SetCategory(MemoryCategory::DAG_CACHE);
     timer_automaton.start();
     this->_automaton = (this->_monaAST->formula)->toSymbolicAutomaton(false);
 
@@ -112,6 +126,34 @@ Decision SymbolicChecker::_DecideCore(bool isValid) {
     }
 }
 
+/**
+ * Prints the coloured @p decision to the output
+ *
+ * @param[in] decision:     decision of the formula
+ */
+void SymbolicChecker::_PrintDecision(Decision decision) {
+    switch(decision) {
+        case Decision::SATISFIABLE:
+            std::cout << "\033[1;34m'SATISFIABLE'\033[0m";
+            break;
+        case Decision::UNSATISFIABLE:
+            std::cout << "\033[1;31m'UNSATISFIABLE'\033[0m";
+            break;
+        case Decision::VALID:
+            std::cout << "\033[1;32m'VALID'\033[0m";
+            break;
+        case Decision::UNKNOWN:
+            std::cout << "\033[1;33m'UNKNOWN'\033[0m";
+            break;
+        case Decision::INVALID:
+            std::cout << "\033[1;36m'INVALID'\033[0m";
+            break;
+        default:
+            std::cout << "undecided due to an error.\n";
+            break;
+    }
+}
+
 /**
  * Core of the Symbolic Decision procedure, Runs the procedure and prints the result according to the call of the
  * core function. Moreover prints various timings.
@@ -124,32 +166,15 @@ void SymbolicChecker::Decide() {
         bool decided;
         // Deciding WS1S formula
         timer_deciding.start();
+        std::uint64_t traceStart = Tracer::Now();
+        LiveStats::EnterPhase("decision");
         decided = this->Run();
+        Tracer::Complete("decision", "phase", traceStart);
         timer_deciding.stop();
 
         // Outing the results of decision procedure
         std::cout << "[!] Formula is ";
-        switch(this->_DecideCore(decided)) {
-            case Decision::SATISFIABLE:
-                std::cout << "\033[1;34m'SATISFIABLE'\033[0m";
-                break;
-            case Decision::UNSATISFIABLE:
-                std::cout << "\033[1;31m'UNSATISFIABLE'\033[0m";
-                break;
-            case Decision::VALID:
-                std::cout << "\033[1;32m'VALID'\033[0m";
-                break;
-            case Decision::UNKNOWN:
-                std::cout << "\033[1;33m'UNKNOWN'\033[0m";
-                break;
-            case Decision::INVALID:
-                std::cout << "\033[1;36m'INVALID'\033[0m";
-                break;
-            default:
-                std::cout << "undecided due to an error.\n";
-                break;
-        }
-
+        this->_PrintDecision(this->_DecideCore(decided));
         std::cout << "\n";
         std::cout << "[*] Formula parse:      ";
         timer_parse.print();
@@ -189,7 +214,7 @@ int count_example_len(Term* t) {
     while(t != nullptr && std::find_if(processed.begin(), processed.end(), [&t](Term_ptr i) { return t == i; }) == processed.end()) {
         ++len;
         processed.push_back(t);
-        t = t->link->succ;
+        t = (t->link != nullptr ? t->link->succ : nullptr);
     }
     return len;
 }
@@ -199,11 +224,23 @@ void sig_handler(int signum) {
     throw GastonSignalException(signum);
 }
 
+/**
+ * Handler of the interrupting signals, only raises the flag, that is processed at the next safe point
+ */
+void interrupt_handler(int signum) {
+    ResourceGovernor::Interrupt(signum);
+}
+
+/**
+ * Handler of failed allocations: releases the caches and requests the stop at the next safe point. If the
+ * allocation fails again, std::bad_alloc is thrown. The handler is reinstalled by ResourceGovernor::Start.
+ */
 void g_new_handler() {
     AST::temporalMapping.clear();
     SymbolicAutomaton::dagNegNodeCache->clear();
     SymbolicAutomaton::dagNodeCache->clear();
-    throw GastonOutOfMemory();
+    ResourceGovernor::RequestStop(GovernorStatus::OUT_OF_MEMORY);
+    std::set_new_handler(nullptr);
 }
 
 /**
@@ -261,29 +298,50 @@ bool SymbolicChecker::Run() {
 #   endif
 
     // Initialize signal handlers for timeouts, in order to be polite and clean
-    signal(SIGINT, sig_handler);
+    signal(SIGINT, interrupt_handler);
+    signal(SIGTERM, interrupt_handler);
 #   if (DEBUG_DONT_CATCH_SIGSEGV == false)
     signal(SIGSEGV, sig_handler); // This might be suicidal though
 #   endif
-    std::set_new_handler(g_new_handler);
+    ResourceGovernor::Start(options.timeout, options.memLimit, options.stepLimit, g_new_handler);
+    AutomatonProfiler::enabled = options.profile;
+    Term::witnessTracking = !options.decideOnly;
+    TermFixpoint::bestFirstSearch = (OPT_FIXPOINT_BEST_FIRST_SEARCH == true || options.bestFirst);
+    bool replayWitnesses = options.decideOnly && (options.replayWitnesses || options.verifyModels);
 
     // Checks if Initial States intersect Final states
     std::pair<Term_ptr, bool> result;
+    bool outOfMemory = false;
     try {
         result = this->_automaton->IntersectNonEmpty(nullptr, finalStatesApproximation, false);
+        if(replayWitnesses && this->_automaton->type == AutType::PROJECTION
+           && static_cast<ProjectionAutomaton*>(this->_automaton)->IsRoot()
+           && (this->_automaton->_satExample != nullptr || this->_automaton->_unsatExample != nullptr)) {
+            // The decision is already known, only the links of the found examples are formed again
+            LiveStats::EnterPhase("witness replay");
+            RootProjectionAutomaton* root = static_cast<RootProjectionAutomaton*>(this->_automaton);
+            result.first = root->ReplayWitnesses(result.first, finalStatesApproximation, false).first;
+        }
+    } catch (const GastonResourceExhausted& exception) {
+        std::cout << "[!] " << exception.what() << "\n";
+        outOfMemory = (exception.GetStatus() == GovernorStatus::OUT_OF_MEMORY);
+        this->_terminatedBySignal = true;
     } catch (const GastonSignalException& exception) {
         std::cout << exception.what() << "\n";
         this->_terminatedBySignal = true;
-    } catch (const GastonOutOfMemory& exception) {
-        std::cout << exception.what() << "\n";
+    } catch (const std::bad_alloc& exception) {
+        std::cout << "[!] Decision procedure ran out of memory\n";
+        outOfMemory = true;
         this->_terminatedBySignal = true;
     }
     Term_ptr fixpoint = result.first;
     bool isValid = result.second;
 
 #   if (DUMP_EXAMPLES == true)
-    this->_ProcessExample(this->_automaton->_satExample, ExampleType::SATISFYING);
-    this->_ProcessExample(this->_automaton->_unsatExample, ExampleType::UNSATISFYING);
+    if(!options.decideOnly || replayWitnesses) {
+        this->_ProcessExample(this->_automaton->_satExample, ExampleType::SATISFYING);
+        this->_ProcessExample(this->_automaton->_unsatExample, ExampleType::UNSATISFYING);
+    }
 #   endif
 
 #   if (DEBUG_FIXPOINT == true)
@@ -300,6 +358,8 @@ bool SymbolicChecker::Run() {
 #   endif
 
     std::cout << "\t\u2218 Partial Subsumption Hits: " << Term::partial_subsumption_hits << "\n";
+    std::cout << "\t\u2218 Governor Steps: " << ResourceGovernor::GetSteps();
+    std::cout << " (peak memory = " << (ResourceGovernor::GetPeakMemory() >> 10) << "MB)\n";
 #   if (MEASURE_STATE_SPACE == true)
 #   define OUTPUT_MEASURES(TermType) \
         std::cout << "\t\t\u2218 prunnable: " << TermType::prunable << "\n"; \
@@ -361,10 +421,22 @@ bool SymbolicChecker::Run() {
 #   endif
 #   undef OUTPUT_MEASURES
     std::cout << "[*] Mona State Space: " << (Workshops::TermWorkshop::monaAutomataStates) << "\n";
+#   if (OPT_SHARE_MONA_CODE == true)
+    std::cout << "[*] Reused Mona DFAs: " << (codeTable != nullptr ? codeTable->reused : 0) << "\n";
+#   endif
     std::cout << "[*] Overall State Space: " << (TermProduct::instances + TermBaseSet::instances + TermFixpoint::instances
                                                  + TermList::instances + TermContinuation::instances + TermNaryProduct::instances
                                                  + TermTernaryProduct::instances + Workshops::TermWorkshop::monaAutomataStates) << "\n";
     std::cout << "[*] Explored Fixpoint Space: " << (fixpoint != nullptr ? fixpoint->MeasureStateSpace() : 0) << "\n";
+#   if (OPT_RECLAIM_DEAD_TERMS == true)
+    std::cout << "[*] Reclaimed Terms: " << TermReclaimer::reclaimed << " (" << TermReclaimer::reclaimedBytes << "B in " << TermReclaimer::collections << " collections)\n";
+#   endif
+    if(options.naryWorkers != 0) {
+        std::cout << "[*] Nary Probes: " << ProbePool::started << " (" << ProbePool::foundEmpty << " found empty operand)\n";
+    }
+#   endif
+#   if (MEASURE_MONA_TABLE_BUCKETS == true)
+    symbolTable.print_bucket_statistics();
 #   endif
 
 #   if (PRINT_STATS == true)
@@ -375,6 +447,16 @@ bool SymbolicChecker::Run() {
     }
 #   endif
 
+    if(options.profile) {
+        AutomatonProfiler::enabled = false;
+        SymbolicAutomaton::DumpProfile(this->_automaton, this->GetProfileFilename());
+    }
+
+    // On out of memory we always dump the accounting to see which subsystem was the culprit
+    if(options.memStats || outOfMemory) {
+        MemoryAccounting::Dump(std::cout);
+    }
+
     // If Initial States does intersect final ones, the formula is valid, else it is unsatisfiable
     return isValid;
 }
@@ -396,6 +478,22 @@ std::string SymbolicChecker::GetProofFormulaFilename(ExampleType exType) {
     return path;
 }
 
+/**
+ * Returns the filename of the dot with the profile of the automaton, either given by --profile=FILE or in form of
+ *   'inputFilename_profile.dot'
+ *
+ * @return  filename for the profile
+ */
+std::string SymbolicChecker::GetProfileFilename() {
+    if(options.profileFile != nullptr) {
+        return std::string(options.profileFile);
+    }
+    std::string path(inputFileName);
+    path  = path.substr(0, path.find_last_of("."));
+    path += "_profile.dot";
+    return path;
+}
+
 /**
  * @brief Generates formula that serves as proof for @p example
  *
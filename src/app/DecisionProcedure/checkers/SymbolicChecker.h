@@ -19,6 +19,7 @@ public:
     bool Run();
     void GenerateProofFormulaeFor(Term_ptr example, ExampleType);
     static std::string GetProofFormulaFilename(ExampleType);
+    static std::string GetProfileFilename();
 protected:
     SymbolicAutomaton* _automaton;
     std::vector<std::string> _satInterpretation;
@@ -28,6 +29,7 @@ protected:
 
     // <<< PRIVATE METHODS >>>
     Decision _DecideCore(bool);
+    void _PrintDecision(Decision);
 };
 
 
@@ -15,13 +15,19 @@
 
 #include <list>
 #include <stdint.h>
+#include <cstdio>
+#include <algorithm>
+#include <iomanip>
 #include "SymbolicAutomata.h"
 #include "Term.h"
 #include "../environment.hh"
 #include "../checkers/Checker.h"
 #include "../containers/VarToTrackMap.hh"
 #include "../containers/Workshops.h"
+#include "../containers/TermReclaimer.h"
 #include "../utils/Timer.h"
+#include "../utils/ProbePool.h"
+#include "../utils/Tracer.h"
 #include "../../Frontend/dfa.h"
 #include "../../Frontend/env.h"
 #include "../../Frontend/symboltable.h"
@@ -35,6 +41,9 @@ extern char *inputFileName;
 StateType SymbolicAutomaton::stateCnt = 0;
 DagNodeCache* SymbolicAutomaton::dagNodeCache = new DagNodeCache();
 DagNodeCache* SymbolicAutomaton::dagNegNodeCache = new DagNodeCache();
+std::vector<SymbolicAutomaton*> SymbolicAutomaton::_profiledNodes;
+std::uint64_t SymbolicAutomaton::_maxSelfTime = 0;
+bool SymbolicAutomaton::_dumpProfile = false;
 
 using namespace Gaston;
 
@@ -73,7 +82,19 @@ void SymLink::InitializeSymLink(ASTForm* form) {
 
 ZeroSymbol* SymLink::ReMapSymbol(ZeroSymbol* symbol) {
     if(this->remap && symbol != nullptr) {
+        if(AutomatonProfiler::enabled) {
+            ++this->aut->profile.remappedUses;
+        }
+#       if (OPT_SYMBOL_TABLES == true)
+        ZeroSymbol* remapped = this->remapTable.Lookup(symbol);
+        if(remapped == nullptr) {
+            remapped = this->aut->symbolFactory.CreateRemappedSymbol(symbol, this->varRemap, this->remap_tag);
+            this->remapTable.Store(symbol, remapped);
+        }
+        return remapped;
+#       else
         return this->aut->symbolFactory.CreateRemappedSymbol(symbol, this->varRemap, this->remap_tag);
+#       endif
     } else {
         return symbol;
     }
@@ -129,7 +150,8 @@ SymbolicAutomaton::SymbolicAutomaton(Formula_ptr form) :
     // Fixme: isn't allVars the same as formula->allVars?
     this->_InitializeOccuringVars();
     this->_InitializeNonOccuring();
-
+    this->_resCache.SetCategory(MemoryCategory::RESULT_CACHE);
+    this->_subCache.SetCategory(MemoryCategory::SUBSUMPTION_CACHE);
 }
 
 SymbolicAutomaton::~SymbolicAutomaton() {
@@ -196,13 +218,14 @@ TernaryOpAutomaton::~TernaryOpAutomaton() {
     }
 }
 
-void collect_leaves(ASTKind k, ASTForm* form, std::vector<ASTForm*>& leaves, ASTForm*& qf_free) {
-    if(form->kind == k) {
+void collect_leaves(ASTKind k, ASTForm* form, std::vector<ASTForm*>& leaves, ASTForm*& qf_free, bool clustered = false) {
+    if(form->kind == k && (!clustered || form->is_cluster_product)) {
         ASTForm_ff* ff_form = static_cast<ASTForm_ff*>(form);
-        collect_leaves(k, ff_form->f1, leaves, qf_free);
-        collect_leaves(k, ff_form->f2, leaves, qf_free);
+        collect_leaves(k, ff_form->f1, leaves, qf_free, form->is_cluster_product);
+        collect_leaves(k, ff_form->f2, leaves, qf_free, form->is_cluster_product);
     } else {
-        if(form->fixpoint_number > 0) {
+        // Clusters of the product are kept as separate leaves
+        if(form->fixpoint_number > 0 || clustered) {
             leaves.push_back(form);
         } else {
             // Collect qf_free stuff to the same shit
@@ -306,12 +329,20 @@ BaseProjectionAutomaton::BaseProjectionAutomaton(SymbolicAutomaton* aut, Formula
 
 BaseAutomaton::BaseAutomaton(BaseAutomatonType* aut, size_t vars, Formula_ptr form, bool emptyTracks) : SymbolicAutomaton(form), _autWrapper(dfaCopy(aut), emptyTracks, form->is_restriction, vars) {
     type = AutType::BASE;
+#   if (OPT_USE_SET_PRE == true)
+    this->_setCache.SetCategory(MemoryCategory::PRE_CACHE);
+#   else
+    this->_preCache.SetCategory(MemoryCategory::PRE_CACHE);
+#   endif
+    this->_InitializePreBackend(aut, vars);
     this->_InitializeAutomaton();
     this->_stateSpace = vars;
 }
 
 BaseAutomaton::~BaseAutomaton() {
-
+    if(this->_mtbddWrapper != nullptr) {
+        delete this->_mtbddWrapper;
+    }
 }
 
 // Derive of BinaryOpAutomaton
@@ -549,6 +580,10 @@ NaryBiimplicationAutomaton::NaryBiimplicationAutomaton(Formula_ptr form, bool un
  */
 ResultType SymbolicAutomaton::IntersectNonEmpty(Symbol* symbol, Term* stateApproximation, bool underComplement) {
     assert(stateApproximation != nullptr);
+    AutomatonProfiler::Scope profileScope(this->profile);
+    if(AutomatonProfiler::enabled && ++this->profile.calls == 1) {
+        SymbolicAutomaton::_profiledNodes.push_back(this);
+    }
 #   if (MEASURE_SUBAUTOMATA_TIMING == true)
     this->timer.Start();
 #   endif
@@ -618,6 +653,9 @@ ResultType SymbolicAutomaton::IntersectNonEmpty(Symbol* symbol, Term* stateAppro
 #       endif
         assert(result.first != nullptr);
         this->_lastResult = result.second;
+        if(AutomatonProfiler::enabled) {
+            ++this->profile.cacheHits;
+        }
 #       if (MEASURE_SUBAUTOMATA_TIMING == true)
         this->timer.Stop();
 #       endif
@@ -686,6 +724,10 @@ ResultType SymbolicAutomaton::IntersectNonEmpty(Symbol* symbol, Term* stateAppro
 
 ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* finalApproximation, bool underComplement) {
     assert(this->_unsatExample == nullptr && this->_satExample == nullptr);
+    AutomatonProfiler::Scope profileScope(this->profile);
+    if(AutomatonProfiler::enabled && ++this->profile.calls == 1) {
+        SymbolicAutomaton::_profiledNodes.push_back(this);
+    }
 
     // We are doing the initial step by evaluating the epsilon
     TermList* projectionApproximation = reinterpret_cast<TermList*>(finalApproximation);
@@ -711,7 +753,8 @@ ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* fina
     timer_paths.start();
 #   endif
     // While the fixpoint is not fully unfolded and while we cannot evaluate early
-    while((this->_satExample == nullptr || this->_unsatExample == nullptr) && ((fixpointTerm = it.GetNext()) != nullptr)) {
+    while(((this->_searchSat && this->_satExample == nullptr) || (this->_searchUnsat && this->_unsatExample == nullptr))
+          && ((fixpointTerm = it.GetNext()) != nullptr)) {
         if(allPosVar != -1 && options.test != TestType::EVERYTHING) {
             if (options.test == TestType::VALIDITY && this->_unsatExample != nullptr) {
                 break;
@@ -721,13 +764,19 @@ ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* fina
             }
         }
         fixpoint->RemoveSubsumed();
+#       if (OPT_RECLAIM_DEAD_TERMS == true)
+        // Root iteration is the only point, where no other terms are held on the stack
+        if(TermReclaimer::ShouldCollect()) {
+            TermReclaimer::Collect(this, {finalApproximation, result.first, fixpoint, fixpointTerm});
+        }
+#       endif
 #       if (DEBUG_EXAMPLE_PATHS == true)
-        if(fixpointTerm != nullptr && fixpointTerm->link->len > maxPath) {
+        if(fixpointTerm != nullptr && fixpointTerm->len > maxPath) {
             std::cout << "[*] Finished exploring examples of length '" << maxPath << "': ";
             timer_paths.stop();
             timer_paths.print();
             timer_paths.start();
-            maxPath = fixpointTerm->link->len;
+            maxPath = fixpointTerm->len;
 #           if (DEBUG_MAX_SEARCH_PATH > 0)
             if(maxPath > DEBUG_MAX_SEARCH_PATH) {
                 std::cout << "[!] Maximal search depth reached!\n";
@@ -744,7 +793,7 @@ ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* fina
         else
             std::cout << "nullptr";
         std::cout << " + ";
-        if(fixpointTerm != nullptr && fixpointTerm->link->symbol != nullptr) {
+        if(fixpointTerm != nullptr && fixpointTerm->link != nullptr) {
             std::cout << (*fixpointTerm->link->symbol);
         } else {
             std::cout << "''";
@@ -786,6 +835,32 @@ ResultType RootProjectionAutomaton::IntersectNonEmpty(Symbol* symbol, Term* fina
     return std::make_pair(fixpoint, fixpoint->GetResult());
 }
 
+/**
+ * Replays the search of the root after the decision was made without tracking of witnesses (decide-only mode).
+ * The root @p fixpoint is computed anew with links formed, while the subautomata answer mostly from their
+ * caches, and the search stops as soon as the examples found during the decision are found again.
+ *
+ * @param[in]  fixpoint  root fixpoint computed during the decision
+ * @param[in]  finalApproximation  approximation of final states the decision started from
+ * @param[in]  underComplement  true if we are under the complement
+ * @return  new root fixpoint and its result
+ */
+ResultType RootProjectionAutomaton::ReplayWitnesses(Term* fixpoint, Term* finalApproximation, bool underComplement) {
+    Tracer::Scope traceScope("witness replay", "phase");
+    this->_searchSat = (this->_satExample != nullptr);
+    this->_searchUnsat = (this->_unsatExample != nullptr);
+    this->_satExample = nullptr;
+    this->_unsatExample = nullptr;
+
+    if(fixpoint->type == TermType::FIXPOINT) {
+        this->_factory.DestroyFixpoint(static_cast<TermFixpoint*>(fixpoint));
+    }
+    Term::witnessTracking = true;
+    ResultType result = this->IntersectNonEmpty(nullptr, finalApproximation, underComplement);
+    this->_searchSat = this->_searchUnsat = true;
+    return result;
+}
+
 /**
  * Lazy evaluation of final states. If states are not initialized, they are recreated and returned
  *
@@ -835,6 +910,86 @@ void BaseAutomaton::_InitializeAutomaton() {
     this->_InitializeFinalStates();
 }
 
+/**
+ * Selects how the pre is computed for the automaton: small automata use the explicit pre
+ * table, automata with enough states can use the MTBDD backend and the rest falls back
+ * to walking the bdds in mona wrapper.
+ *
+ * @param[in] aut:      mona automaton
+ * @param[in] vars:     number of tracks
+ */
+void BaseAutomaton::_InitializePreBackend(BaseAutomatonType* aut, size_t vars) {
+#   if (OPT_USE_EXPLICIT_PRE_TABLES == true)
+    if(this->_autWrapper.BuildPreTable(OPT_EXPLICIT_PRE_TABLE_BUDGET)) {
+#       if (OPT_USE_BASE_SIMULATION == true)
+        this->_hasSimulation = this->_autWrapper.ComputeBackwardSimulation(this->_simulation);
+#       endif
+        return;
+    }
+#   endif
+#   if (OPT_USE_MTBDD_BASE_BACKEND == true)
+    if(aut->ns >= OPT_MTBDD_BACKEND_MIN_STATES) {
+        this->_mtbddWrapper = new MTBDDWrapper<size_t>(aut, this->_autWrapper.GetInitialState(), vars);
+    }
+#   endif
+}
+
+/**
+ * Tests whether each state of @p lhs is simulated by some state of @p rhs
+ *
+ * @param[in] lhs:      tested set of states
+ * @param[in] rhs:      set of states that should simulate @p lhs
+ * @param[out] diff:    if not null, states of @p lhs that are not simulated by @p rhs
+ * @return: true if @p lhs is simulated by @p rhs
+ */
+bool BaseAutomaton::IsSimulatedBy(BaseAutomatonStateSet const& lhs, BaseAutomatonStateSet const& rhs, BaseAutomatonStateSet* diff) {
+    bool result = true;
+    for(auto p : lhs) {
+        bool simulated = false;
+        for(auto q : rhs) {
+            if(this->_Simulates(p, q)) {
+                simulated = true;
+                break;
+            }
+        }
+        if(!simulated) {
+            result = false;
+            if(diff == nullptr) {
+                break;
+            }
+            diff->insert(p);
+        }
+    }
+    return result;
+}
+
+/**
+ * Removes the states of @p states that are simulated by other state in @p states; from the
+ * mutually simulating states only the smallest one is kept. The result is the smallest set
+ * representing @p states up to simulation; keeping the simulated states instead would lose
+ * the behaviours of the states that simulate them.
+ *
+ * @param[in,out] states:   pruned set of states
+ */
+void BaseAutomaton::PruneSimulated(BaseAutomatonStateSet& states) {
+    BaseAutomatonStateSet pruned;
+    for(auto p : states) {
+        bool dominated = false;
+        for(auto q : states) {
+            if(p != q && this->_Simulates(p, q) && (!this->_Simulates(q, p) || q < p)) {
+                dominated = true;
+                break;
+            }
+        }
+        if(!dominated) {
+            pruned.insert(p);
+        }
+    }
+    if(pruned.size() != states.size()) {
+        states = pruned;
+    }
+}
+
 void BinaryOpAutomaton::_InitializeAutomaton() {
     this->_factory.InitializeWorkshop();
     this->_InitializeInitialStates();
@@ -1022,6 +1177,17 @@ Term* BaseAutomaton::Pre(Symbol* symbol, Term* finalApproximation, bool underCom
 
     // Reinterpret the approximation as base states
     TermBaseSet* baseSet = reinterpret_cast<TermBaseSet*>(finalApproximation);
+#   if (OPT_USE_EXPLICIT_PRE_TABLES == true)
+    // Small automata have the pre precomputed, so it is just the lookup and union of rows
+    if(this->_autWrapper.HasPreTable()) {
+        return this->_factory.CreateBaseSet(this->_autWrapper.TablePre(baseSet->states, symbol->GetTrackMask()));
+    }
+#   endif
+#   if (OPT_USE_MTBDD_BASE_BACKEND == true)
+    if(this->_mtbddWrapper != nullptr) {
+        return this->_factory.CreateBaseSet(this->_mtbddWrapper->Pre(baseSet->states, symbol->GetTrackMask()));
+    }
+#   endif
 #   if (OPT_USE_SET_PRE == true)
     Term_ptr accumulatedState = nullptr;
     auto key = std::make_pair(baseSet->states, symbol);
@@ -1201,7 +1367,36 @@ ResultType NaryOpAutomaton::_IntersectNonEmptyCore(Symbol* symbol, Term* finalAp
     ResultType result;
     bool bool_result = !this->_early_val(underComplement);
     Term_ptr* terms = new Term_ptr[this->_arity];
+#   if (OPT_PRUNE_EMPTY == true)
+    // Projections from the back are probed by the workers, while the operands are evaluated from the front
+    ProbePool probes;
+    size_t probed = this->_arity;
+    bool probing = this->_productType == ProductType::INTERSECTION && this->_arity >= OPT_NARY_PROBE_MIN_ARITY
+                   && ProbePool::Enabled();
+#   endif
     for(auto i = 0; i < this->_arity; ++i) {
+#       if (OPT_PRUNE_EMPTY == true)
+        size_t empty;
+        if(probing && probes.TakeEmpty(empty)) {
+            // Worker found the empty operand, so the rest are cancelled and only the empty one is evaluated
+            probes.CancelAll();
+            result = this->_auts[empty].aut->IntersectNonEmpty(this->_auts[empty].ReMapSymbol(symbol), termNaryProduct->terms[empty], underComplement);
+            if(result.first->type == TermType::EMPTY && !result.first->InComplement()) {
+                delete[] terms;
+                return std::make_pair(result.first, underComplement);
+            }
+        }
+        while(probing && probed > static_cast<size_t>(i) + 1 && probes.HasFreeWorker()) {
+            SymLink* operand = &this->_auts[--probed];
+            Term* term = termNaryProduct->terms[probed];
+            if(operand->aut->type == AutType::PROJECTION) {
+                probes.Start(probed, [operand, symbol, term, underComplement]() {
+                    ResultType probe = operand->aut->IntersectNonEmpty(operand->ReMapSymbol(symbol), term, underComplement);
+                    return probe.first->type == TermType::EMPTY && !probe.first->InComplement();
+                });
+            }
+        }
+#       endif
         result = this->_auts[i].aut->IntersectNonEmpty(this->_auts[i].ReMapSymbol(symbol), termNaryProduct->terms[i], underComplement);
 #       if (OPT_PRUNE_EMPTY == true)
         if(result.first->type == TermType::EMPTY && !result.first->InComplement() && this->_productType == ProductType::INTERSECTION) {
@@ -1501,7 +1696,7 @@ void ProjectionAutomaton::_DumpExampleCore(std::ostream& out, ExampleType e, Int
     int max_len = max_varname_lenght(this->projectedVars, varNo);
 
     std::vector<Term_ptr> processed;
-    while(example != nullptr && example->link->succ != nullptr && example != example->link->succ) {
+    while(example != nullptr && example->link != nullptr && example->link->succ != nullptr && example != example->link->succ) {
     //                                                           ^--- not sure this is right
         if(std::find_if(processed.begin(), processed.end(), [&example](Term_ptr i) { return example == i; }) != processed.end())
             break;
@@ -1816,6 +2011,7 @@ void SymbolicAutomaton::DumpProductHeader(std::ofstream & os, bool inComplement,
         os << ",style=filled, fillcolor=red";
     }
 #   endif
+    this->_DumpProfileToDot(os);
     os << "];\n";
 }
 
@@ -1866,6 +2062,7 @@ void ComplementAutomaton::DumpToDot(std::ofstream & os, bool inComplement) {
         os << ",style=filled, fillcolor=red";
     }
 #   endif
+    this->_DumpProfileToDot(os);
     os << "];\n";
     os << "\t" << (uintptr_t) &*this << " -- " << (uintptr_t) (this->_aut.aut) << ";\n";
     this->_aut.aut->DumpToDot(os, !inComplement);
@@ -1886,6 +2083,7 @@ void ProjectionAutomaton::DumpToDot(std::ofstream & os, bool inComplement) {
         os << ",style=filled, fillcolor=red";
     }
 #   endif
+    this->_DumpProfileToDot(os);
     os << "];\n";
     os << "\t" << (uintptr_t) &*this << " -- " << (uintptr_t) (this->_aut.aut) << ";\n";
     this->_aut.aut->DumpToDot(os, inComplement);
@@ -1936,10 +2134,67 @@ void BaseAutomaton::DumpToDot(std::ofstream & os, bool inComplement) {
     if(this->_isRestriction) {
         os << ", shape=rect";
     }
+    this->_DumpProfileToDot(os);
     os << "];\n";
 
 }
 
+/**
+ * Dumps the profile of the node as additional attributes of the node in dot, hot nodes (w.r.t. their self time)
+ * are filled with shades of red.
+ *
+ * @param[in]  os  output stream
+ */
+void SymbolicAutomaton::_DumpProfileToDot(std::ofstream &os) {
+    if(!SymbolicAutomaton::_dumpProfile) {
+        return;
+    }
+
+    double heat = (SymbolicAutomaton::_maxSelfTime == 0 ? 0.0 : this->profile.selfTime / (double) SymbolicAutomaton::_maxSelfTime);
+    int shade = 255 - static_cast<int>(heat * 255);
+    char colour[8];
+    snprintf(colour, sizeof(colour), "#ff%02x%02x", shade, shade);
+    os << ", xlabel=\"" << (this->profile.selfTime / 1000000) << "/" << (this->profile.inclusiveTime / 1000000) << "ms, ";
+    os << this->profile.calls << " calls\"";
+    os << ", style=filled, fillcolor=\"" << colour << "\"";
+}
+
+/**
+ * Samples the sizes of the result and subsumption caches of the automaton to the trace
+ */
+void SymbolicAutomaton::TraceCacheSizes() {
+    Tracer::Counter("caches", this, "results", this->_resCache.GetSize(), "subsumption", this->_subCache.GetSize());
+}
+
+/**
+ * Prints the table of profiled nodes sorted by their self time and dumps the automaton @p aut with the profile
+ * to the @p path
+ *
+ * @param[in]  aut  root of the profiled automaton
+ * @param[in]  path  path of the dot file with the profile
+ */
+void SymbolicAutomaton::DumpProfile(SymbolicAutomaton* aut, std::string const& path) {
+    std::vector<SymbolicAutomaton*> nodes(SymbolicAutomaton::_profiledNodes);
+    std::sort(nodes.begin(), nodes.end(), [](SymbolicAutomaton* lhs, SymbolicAutomaton* rhs) {
+        return lhs->profile.selfTime > rhs->profile.selfTime;
+    });
+    SymbolicAutomaton::_maxSelfTime = (nodes.empty() ? 0 : nodes.front()->profile.selfTime);
+
+    std::cout << "[*] Profile of symbolic automaton (sorted by self time):\n";
+    std::cout << "#self[ms]\tincl[ms]\tcalls\tcache-hits\tremapped\tterms\tnode\n";
+    for(auto node : nodes) {
+        std::cout << std::fixed << std::setprecision(3) << (node->profile.selfTime / 1e6) << "\t";
+        std::cout << (node->profile.inclusiveTime / 1e6) << "\t";
+        std::cout << node->profile.calls << "\t" << node->profile.cacheHits << "\t";
+        std::cout << node->profile.remappedUses << "\t" << node->profile.termsCreated << "\t";
+        std::cout << "[" << node << "] " << utf8_substr(node->_form->ToString(), PRINT_DOT_LIMIT) << "\n";
+    }
+
+    SymbolicAutomaton::_dumpProfile = true;
+    SymbolicAutomaton::AutomatonToDot(path, aut, false);
+    SymbolicAutomaton::_dumpProfile = false;
+}
+
 /**
  * Renames the states according to the translation function so we get unique states.
  */
@@ -2223,6 +2478,16 @@ void SymbolicAutomaton::DumpAutomatonMetrics() {
     print_stat("Cycles on all final states", (MonaWrapper<size_t>::noAllFinalStatesHasCycles / (double) MonaWrapper<size_t>::_wrapperCount)*100, "%");
     print_stat("Cycles on some final states", (MonaWrapper<size_t>::noSomeFinalStatesHasCycles / (double) MonaWrapper<size_t>::_wrapperCount)*100, "%");
 #   endif
+#   if (OPT_USE_EXPLICIT_PRE_TABLES == true)
+    print_stat("Explicit Pre Tables", static_cast<unsigned int>(MonaWrapper<size_t>::_tableCount));
+    print_stat("Explicit Pre Tables Size", MonaWrapper<size_t>::_tableBytes / 1024.0, "kB");
+#   endif
+#   if (OPT_USE_MTBDD_BASE_BACKEND == true)
+    print_stat("MTBDD Pre Backends", static_cast<unsigned int>(MTBDDWrapper<size_t>::_wrapperCount));
+    print_stat("MTBDD Pre Cache Hits", static_cast<unsigned int>(MTBDDWrapper<size_t>::cacheHits));
+    print_stat("MTBDD Pre Cache Misses", static_cast<unsigned int>(MTBDDWrapper<size_t>::cacheMisses));
+    print_stat("MTBDD Pre Cache Purges", static_cast<unsigned int>(MTBDDWrapper<size_t>::cachePurges));
+#   endif
 }
 
 void ProjectionAutomaton::FillStats() {
@@ -2342,6 +2607,44 @@ void BaseAutomaton::FillStats() {
     this->stats.avg_fixpoint_width = 0.0;
 }
 
+/**
+ * Pushes the direct subautomata of the node to @p nodes
+ *
+ * @param[out]  nodes  vector of collected automata
+ */
+void ProjectionAutomaton::GetSubautomata(std::vector<SymbolicAutomaton*>& nodes) {
+    nodes.push_back(this->_aut.aut);
+}
+
+void BinaryOpAutomaton::GetSubautomata(std::vector<SymbolicAutomaton*>& nodes) {
+    nodes.push_back(this->_lhs_aut.aut);
+    if(this->_rhs_aut.aut != nullptr) {
+        nodes.push_back(this->_rhs_aut.aut);
+    }
+}
+
+void TernaryOpAutomaton::GetSubautomata(std::vector<SymbolicAutomaton*>& nodes) {
+    nodes.push_back(this->_lhs_aut.aut);
+    if(this->_mhs_aut.aut != nullptr) {
+        nodes.push_back(this->_mhs_aut.aut);
+    }
+    if(this->_rhs_aut.aut != nullptr) {
+        nodes.push_back(this->_rhs_aut.aut);
+    }
+}
+
+void NaryOpAutomaton::GetSubautomata(std::vector<SymbolicAutomaton*>& nodes) {
+    for(size_t i = 0; i < this->_arity; ++i) {
+        if(this->_auts[i].aut != nullptr) {
+            nodes.push_back(this->_auts[i].aut);
+        }
+    }
+}
+
+void ComplementAutomaton::GetSubautomata(std::vector<SymbolicAutomaton*>& nodes) {
+    nodes.push_back(this->_aut.aut);
+}
+
 void ComplementAutomaton::FillStats() {
     bool count_inner = !this->_aut.remap;
     if(count_inner) {
@@ -22,8 +22,10 @@
 #include "../mtbdd/void_apply1func.hh"
 #include "../mtbdd/ondriks_mtbdd.hh"
 #include "../mtbdd/monawrapper.hh"
+#include "../mtbdd/mtbddwrapper.hh"
 #include "../utils/Symbol.h"
 #include "../utils/Timer.h"
+#include "../utils/Profiler.h"
 #include "../containers/SymbolicCache.hh"
 #include "../containers/VarToTrackMap.hh"
 #include "../containers/Workshops.h"
@@ -56,6 +58,7 @@ struct SymLink;
 class SymbolicAutomaton {
 public:
     friend class SymbolicChecker;
+    friend class TermReclaimer;
     friend struct SymLink;
 
     using TermWorkshop  = Workshops::TermWorkshop;
@@ -86,6 +89,7 @@ public:
         unsigned int max_refs;
         unsigned int max_symbol_path_len = 0;
     } stats;
+    ProfileRecord profile;          // Runtime profile of the node (see AutomatonProfiler)
 
     Formula_ptr _form;
 protected:
@@ -106,6 +110,9 @@ protected:
     unsigned int _contCreationCounter = 0;
     unsigned int _projectIterationCounter = 0;
     unsigned int _projectSymbolEvaluationCounter = 0;
+    static std::vector<SymbolicAutomaton*> _profiledNodes;
+    static std::uint64_t _maxSelfTime;
+    static bool _dumpProfile;
 
 public:
     AutType type;
@@ -123,6 +130,7 @@ protected:
     virtual void _InitializeFinalStates() = 0;
     virtual ResultType _IntersectNonEmptyCore(Symbol*, Term*, bool) = 0;
     virtual void _DumpExampleCore(std::ostream&, ExampleType, InterpretationType&) = 0;
+    void _DumpProfileToDot(std::ofstream&);
 
 public:
     // <<< CONSTRUCTORS >>>
@@ -150,10 +158,13 @@ public:
     virtual void DumpExample(std::ostream&, ExampleType, InterpretationType&);
     virtual void DumpComputationStats() = 0;
     virtual void FillStats() = 0;
+    virtual void GetSubautomata(std::vector<SymbolicAutomaton*>&) {}
     virtual void DumpProductHeader(std::ofstream&, bool, ProductType);
     virtual void DumpToDot(std::ofstream&, bool) = 0;
     static void AutomatonToDot(std::string, SymbolicAutomaton*, bool);
     static void GastonInfoToDot(std::ofstream&);
+    static void DumpProfile(SymbolicAutomaton*, std::string const&);
+    void TraceCacheSizes();
 protected:
     NEVER_INLINE virtual ~SymbolicAutomaton();
 };
@@ -164,6 +175,9 @@ struct SymLink {
     std::map<unsigned int, unsigned int>* varRemap;
     size_t remap_tag;
     static size_t remap_number;
+#   if (OPT_SYMBOL_TABLES == true)
+    DirectSymbolCache<ZeroSymbol> remapTable;   // < Remapped symbols of the recently remapped source symbols
+#   endif
 
     SymLink() : aut(nullptr), remap(false), varRemap(nullptr), remap_tag(0) {}
     explicit SymLink(SymbolicAutomaton* s) : aut(s), remap(false), varRemap(nullptr), remap_tag(0) {}
@@ -222,6 +236,7 @@ public:
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void DumpComputationStats();
     virtual void FillStats();
+    virtual void GetSubautomata(std::vector<SymbolicAutomaton*>&);
 protected:
     NEVER_INLINE virtual ~BinaryOpAutomaton();
 };
@@ -258,6 +273,7 @@ public:
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void DumpComputationStats();
     virtual void FillStats();
+    virtual void GetSubautomata(std::vector<SymbolicAutomaton*>&);
 
 protected:
     NEVER_INLINE virtual ~TernaryOpAutomaton();
@@ -295,6 +311,7 @@ public:
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void DumpComputationStats();
     virtual void FillStats();
+    virtual void GetSubautomata(std::vector<SymbolicAutomaton*>&);
 
 protected:
     NEVER_INLINE virtual ~NaryOpAutomaton();
@@ -400,6 +417,7 @@ public:
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void DumpComputationStats();
     virtual void FillStats();
+    virtual void GetSubautomata(std::vector<SymbolicAutomaton*>&);
 protected:
     NEVER_INLINE virtual ~ComplementAutomaton();
 };
@@ -456,6 +474,7 @@ public:
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void DumpComputationStats();
     virtual void FillStats();
+    virtual void GetSubautomata(std::vector<SymbolicAutomaton*>&);
 protected:
     NEVER_INLINE virtual ~ProjectionAutomaton();
 };
@@ -467,12 +486,18 @@ protected:
  * fixpoints, by testing the satisfiability and unsatisfiability.
  */
 class RootProjectionAutomaton : public ProjectionAutomaton {
+protected:
+    // <<< PRIVATE MEMBERS >>>
+    bool _searchSat = true;         // < Search continues until the satisfying example is found
+    bool _searchUnsat = true;       // < Search continues until the unsatisfying example is found
+
 public:
     // <<< CONSTRUCTORS >>>
     NEVER_INLINE RootProjectionAutomaton(SymbolicAutomaton*, Formula_ptr);
 
     // <<< PUBLIC API >>>
     virtual ResultType IntersectNonEmpty(Symbol*, Term*, bool);
+    ResultType ReplayWitnesses(Term*, Term*, bool);
 };
 
 class BaseProjectionAutomaton : public ProjectionAutomaton {
@@ -491,9 +516,13 @@ public:
  * Symbolic automaton corresponding to base automata
  */
 class BaseAutomaton : public SymbolicAutomaton {
+    friend class TermReclaimer;
 protected:
     /// <<< PRIVATE MEMBERS >>>
     MonaWrapper<size_t> _autWrapper;                // Wrapper of mona automaton
+    MTBDDWrapper<size_t>* _mtbddWrapper = nullptr;  // Alternative MTBDD backend of pre
+    VATA::Util::BinaryRelation _simulation;         // Backward simulation over states
+    bool _hasSimulation = false;                    // Whether simulation relates some distinct states
     unsigned int _stateSpace = 0;               // Number of states in automaton
     unsigned int _stateOffset = 0;              // Offset of states used for mask
 #   if (OPT_USE_SET_PRE == true)
@@ -508,6 +537,11 @@ protected:
     virtual void _InitializeFinalStates();
     virtual ResultType _IntersectNonEmptyCore(Symbol*, Term*, bool);
     void _RenameStates();
+    void _InitializePreBackend(BaseAutomatonType*, size_t);
+    inline bool _Simulates(size_t p, size_t q) const {
+        // States outside of the automaton are simulated only by themselves
+        return p == q || (p < this->_simulation.size() && q < this->_simulation.size() && this->_simulation.get(p, q));
+    }
     virtual void _DumpExampleCore(std::ostream&, ExampleType, InterpretationType&) {}
 public:
     // <<< CONSTRUCTORS >>>
@@ -517,6 +551,11 @@ public:
     virtual Term* Pre(Symbol*, Term*, bool);
     virtual bool WasLastExampleValid();
 
+    // <<< SIMULATION FUNCTIONS >>>
+    inline bool HasSimulation() const { return this->_hasSimulation; }
+    bool IsSimulatedBy(BaseAutomatonStateSet const&, BaseAutomatonStateSet const&, BaseAutomatonStateSet* diff = nullptr);
+    void PruneSimulated(BaseAutomatonStateSet&);
+
     // <<< DUMPING FUNCTIONS >>>
     virtual void DumpToDot(std::ofstream&, bool);
     virtual void BaseAutDump();
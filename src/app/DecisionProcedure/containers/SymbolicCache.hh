@@ -24,6 +24,8 @@
 #include <typeinfo>
 #include <bitset>
 #include "../environment.hh"
+#include "../utils/MemoryAccounting.h"
+#include "../utils/LiveStats.h"
 #include "../../Frontend/ast.h"
 #include "../../Frontend/symboltable.h"
 
@@ -247,6 +249,9 @@ private:
 	KeyToValueMap _cache;
 	unsigned int cacheHits = 0;
 	unsigned int cacheMisses = 0;
+	MemoryCategory _category = MemoryCategory::OTHER_CACHE;
+	size_t _accountedBytes = 0;
+	size_t _accountedBuckets = 0;
 
 #	if (OPT_CACHE_LAST_QUERIES == true)
 	Key _lastKey[LAST_QUERIES_SIZE];
@@ -262,7 +267,37 @@ public:
         this->_cache.max_load_factor(0.25);
 
 	}
+
+	~BinaryCache() {
+		MemoryAccounting::Release(this->_category, this->_accountedBytes);
+	}
 	// < Public Methods >
+	/**
+	 * @param category: category the memory of the cache is accounted to
+	 */
+	void SetCategory(MemoryCategory category) {
+		MemoryAccounting::Release(this->_category, this->_accountedBytes);
+		this->_category = category;
+		MemoryAccounting::Allocate(this->_category, this->_accountedBytes);
+	}
+
+	/**
+	 * Updates the accounted footprint of the cache, i.e. its bucket array and entries. Insertions update
+	 * it only when the buckets grow, so the entries are accounted in amortized steps.
+	 */
+	void UpdateAccounting() {
+#		if (MEASURE_MEMORY == true)
+		this->_accountedBuckets = this->_cache.bucket_count();
+#		if (OPT_USE_DENSE_HASHMAP == true)
+		size_t bytes = this->_cache.bucket_count()*sizeof(typename KeyToValueMap::value_type);
+#		else
+		size_t bytes = this->_cache.bucket_count()*sizeof(void*)
+		             + this->_cache.size()*(sizeof(typename KeyToValueMap::value_type) + sizeof(void*) + sizeof(size_t));
+#		endif
+		MemoryAccounting::Resize(this->_category, this->_accountedBytes, bytes);
+#		endif
+	}
+
 	/**
 	 * @param key: key of the looked up macro state
 	 * @return: data corresponding to the @p key
@@ -290,6 +325,11 @@ public:
 #		endif
 		this->_cache.emplace(key, data);
 #       endif
+#		if (MEASURE_MEMORY == true)
+		if(this->_cache.bucket_count() != this->_accountedBuckets) {
+			this->UpdateAccounting();
+		}
+#		endif
 	}
 
 	/**
@@ -303,6 +343,7 @@ public:
 		for(size_t i = this->pos, j = 0; j < this->size; ++j) {
 			if(this->_lastKey[i] == key) {
 				++cacheHits;
+				LiveStats::CountLookup(this->_category, true);
 				data = this->_lastData[i];
 				return true;
 			}
@@ -313,21 +354,51 @@ public:
 		auto search = this->_cache.find(key);
 		if (search == this->_cache.end()) {
 			++cacheMisses;
+			LiveStats::CountLookup(this->_category, false);
 			return false;
 		} else {
 			data = search->second;
 			++cacheHits;
+			LiveStats::CountLookup(this->_category, true);
 			return true;
 		}
 	}
 
+	/**
+	 * Erases all of the entries, for which the @p pred(key, data) holds
+	 *
+	 * @param pred: predicate over the key and data
+	 * @return: number of erased entries
+	 */
+	template<class Pred>
+	size_t EraseIf(Pred pred) {
+		size_t erased = 0;
+		for(auto it = this->_cache.begin(); it != this->_cache.end();) {
+			if(pred(it->first, it->second)) {
+				this->_cache.erase(it++);
+				++erased;
+			} else {
+				++it;
+			}
+		}
+#		if (OPT_CACHE_LAST_QUERIES == true)
+		if(erased != 0) {
+			this->size = 0;
+		}
+#		endif
+		this->UpdateAccounting();
+		return erased;
+	}
+
 	/**
 	 * Clears the cache
 	 */
 	void clear() {
-		for(auto itPair = this->_cache.begin(); itPair != this->_cache.end(); ++itPair) {
-			itPair = this->_cache.erase(itPair);
-		}
+		this->_cache.clear();
+#		if (OPT_CACHE_LAST_QUERIES == true)
+		this->size = 0;
+#		endif
+		this->UpdateAccounting();
 	}
 
 	/**
@@ -420,6 +491,14 @@ public:
 		return this->_cache.size();
 	}
 
+	unsigned int GetHits() const {
+		return this->cacheHits;
+	}
+
+	unsigned int GetMisses() const {
+		return this->cacheMisses;
+	}
+
 	inline const_iterator begin() const{
 		return this->_cache.begin();
 	}
@@ -429,4 +508,53 @@ public:
 	}
 };
 
+/**
+ * Direct-mapped cache of the transformed (trimmed or remapped) symbols. Source symbols are mapped to the slots
+ * by their ids and the colliding symbol replaces the previous one, so the lookup is a single array index and
+ * the memory is bounded by OPT_SYMBOL_TABLE_SIZE slots. Slots are allocated by the first store.
+ */
+template<class Symbol>
+class DirectSymbolCache {
+private:
+	struct Slot {
+		size_t id;
+		Symbol* value;
+	};
+	static_assert((OPT_SYMBOL_TABLE_SIZE & (OPT_SYMBOL_TABLE_SIZE - 1)) == 0, "Size of the symbol tables must be power of two");
+
+	Slot* _slots = nullptr;
+
+public:
+	DirectSymbolCache() {}
+	DirectSymbolCache(DirectSymbolCache const&) = delete;
+	DirectSymbolCache& operator=(DirectSymbolCache const&) = delete;
+	~DirectSymbolCache() {
+		if(this->_slots != nullptr) {
+			delete[] this->_slots;
+			MemoryAccounting::Release(MemoryCategory::OTHER_CACHE, OPT_SYMBOL_TABLE_SIZE*sizeof(Slot));
+		}
+	}
+
+	/**
+	 * @return  the stored transformation of @p key or nullptr if it is not in the cache
+	 */
+	inline Symbol* Lookup(Symbol* key) const {
+		if(this->_slots == nullptr) {
+			return nullptr;
+		}
+		Slot const& slot = this->_slots[key->id & (OPT_SYMBOL_TABLE_SIZE - 1)];
+		return (slot.value != nullptr && slot.id == key->id ? slot.value : nullptr);
+	}
+
+	inline void Store(Symbol* key, Symbol* value) {
+		if(this->_slots == nullptr) {
+			this->_slots = new Slot[OPT_SYMBOL_TABLE_SIZE]();
+			MemoryAccounting::Allocate(MemoryCategory::OTHER_CACHE, OPT_SYMBOL_TABLE_SIZE*sizeof(Slot));
+		}
+		Slot& slot = this->_slots[key->id & (OPT_SYMBOL_TABLE_SIZE - 1)];
+		slot.id = key->id;
+		slot.value = value;
+	}
+};
+
 #endif
\ No newline at end of file
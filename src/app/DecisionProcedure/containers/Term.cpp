@@ -15,6 +15,9 @@
 #include "Term.h"
 #include "TermEnumerator.h"
 #include "../environment.hh"
+#include "../utils/ResourceGovernor.h"
+#include "../utils/Tracer.h"
+#include "../utils/MemoryAccounting.h"
 #include <sstream>
 #include <boost/functional/hash.hpp>
 #include <future>
@@ -65,10 +68,15 @@ size_t TermFixpoint::isNotShared = 0;
 size_t TermFixpoint::postponedTerms = 0;
 size_t TermFixpoint::postponedProcessed = 0;
 size_t TermFixpoint::fullyComputedFixpoints = 0;
+size_t TermFixpoint::activeFixpoints = 0;
+TermFixpoint* TermFixpoint::_activeHead = nullptr;
+TermFixpoint::WorklistScoreType TermFixpoint::worklistScore = TermFixpoint::DefaultWorklistScore;
+bool TermFixpoint::bestFirstSearch = OPT_FIXPOINT_BEST_FIRST_SEARCH;
 size_t TermContinuation::continuationUnfolding = 0;
 size_t TermContinuation::unfoldInSubsumption = 0;
 size_t TermContinuation::unfoldInIsectNonempty = 0;
 size_t Term::partial_subsumption_hits = 0;
+bool Term::witnessTracking = true;
 #if (MEASURE_BASE_SIZE == true)
 size_t TermBaseSet::maxBaseSize = 0;
 #endif
@@ -77,7 +85,9 @@ extern Ident lastPosVar, allPosVar;
 
 // <<< TERM CONSTRUCTORS AND DESTRUCTORS >>>
 Term::Term(Aut_ptr aut) : _aut(aut) {
-    this->link = new link_t(nullptr, nullptr, 0);
+    if(aut != nullptr && AutomatonProfiler::enabled) {
+        ++aut->profile.termsCreated;
+    }
 }
 Term::~Term() {
     delete this->link;
@@ -93,6 +103,7 @@ TermEmpty::TermEmpty(Aut_ptr aut, bool inComplement) : Term(aut) {
 #   if (MEASURE_STATE_SPACE == true)
     ++TermEmpty::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_EMPTY, sizeof(TermEmpty));
     if(inComplement) {
         SET_IN_COMPLEMENT(this);
     }
@@ -123,6 +134,7 @@ TermProduct::TermProduct(Aut_ptr aut, Term_ptr lhs, Term_ptr rhs, ProductType pt
 #   if (MEASURE_STATE_SPACE == true)
     ++TermProduct::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_PRODUCT, sizeof(TermProduct));
 
     this->type = TermType::PRODUCT;
     SET_PRODUCT_SUBTYPE(this, pt);
@@ -143,6 +155,7 @@ TermProduct::TermProduct(Aut_ptr aut, Term_ptr lhs, Term_ptr rhs, ProductType pt
 }
 
 TermProduct::~TermProduct() {
+    MemoryAccounting::Release(MemoryCategory::TERM_PRODUCT, sizeof(TermProduct));
 #   if (OPT_ENUMERATED_SUBSUMPTION_TESTING == true)
     if(this->enumerator != nullptr) {
         delete this->enumerator;
@@ -166,6 +179,7 @@ TermTernaryProduct::TermTernaryProduct(Aut_ptr aut, Term_ptr lhs, Term_ptr mhs,
 #   if(MEASURE_STATE_SPACE == true)
     ++TermTernaryProduct::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_TERNARY_PRODUCT, sizeof(TermTernaryProduct));
 
     this->type = TermType::TERNARY_PRODUCT;
     SET_PRODUCT_SUBTYPE(this, pt);
@@ -187,6 +201,7 @@ TermTernaryProduct::TermTernaryProduct(Aut_ptr aut, Term_ptr lhs, Term_ptr mhs,
  * @brief destructs the enumerator of the ternary product
  */
 TermTernaryProduct::~TermTernaryProduct() {
+    MemoryAccounting::Release(MemoryCategory::TERM_TERNARY_PRODUCT, sizeof(TermTernaryProduct));
 #   if (OPT_ENUMERATED_SUBSUMPTION_TESTING == true)
     if(this->enumerator != nullptr)
         delete this->enumerator;
@@ -205,6 +220,7 @@ void TermNaryProduct::_InitNaryProduct(ProductType pt, size_t arity) {
 #   if (MEASURE_STATE_SPACE == true)
     ++TermNaryProduct::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_NARY_PRODUCT, sizeof(TermNaryProduct) + arity*(sizeof(Term_ptr) + sizeof(size_t)));
 
     this->arity = arity;
     this->access_vector = new size_t[this->arity];
@@ -301,6 +317,7 @@ TermNaryProduct::TermNaryProduct(Aut_ptr aut, Term_ptr source, Symbol_ptr symbol
 }
 
 TermNaryProduct::~TermNaryProduct() {
+    MemoryAccounting::Release(MemoryCategory::TERM_NARY_PRODUCT, sizeof(TermNaryProduct) + this->arity*(sizeof(Term_ptr) + sizeof(size_t)));
     delete[] this->access_vector;
     delete[] this->terms;
 
@@ -322,6 +339,7 @@ TermBaseSet::TermBaseSet(Aut_ptr aut, BaseAutomatonStateSet && s) : Term(aut), s
 #   if (MEASURE_STATE_SPACE == true)
     ++TermBaseSet::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_BASE, sizeof(TermBaseSet) + this->states.size()*sizeof(size_t));
 #   if (MEASURE_BASE_SIZE == true)
     size_t size = s.size();
     if(size > TermBaseSet::maxBaseSize) {
@@ -342,6 +360,7 @@ TermBaseSet::TermBaseSet(Aut_ptr aut, BaseAutomatonStateSet && s) : Term(aut), s
 }
 
 TermBaseSet::~TermBaseSet() {
+    MemoryAccounting::Release(MemoryCategory::TERM_BASE, sizeof(TermBaseSet) + this->states.size()*sizeof(size_t));
     this->states.clear();
 }
 
@@ -370,6 +389,7 @@ TermContinuation::TermContinuation(Aut_ptr aut, SymLink* a, SymbolicAutomaton* i
 #   if (MEASURE_STATE_SPACE == true)
     ++TermContinuation::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_CONTINUATION, sizeof(TermContinuation));
     assert(t != nullptr || lazyEval);
     this->type = TermType::CONTINUATION;
 
@@ -398,6 +418,7 @@ TermList::TermList(Aut_ptr aut, Term_ptr first, bool isCompl) : Term(aut), list{
 #   if (MEASURE_STATE_SPACE == true)
     ++TermList::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::TERM_LIST, sizeof(TermList));
 
     this->type = TermType::LIST;
 
@@ -434,11 +455,17 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr startingTerm, Symbol* symbol, b
           _sourceIt(nullptr),
           _baseAut(static_cast<ProjectionAutomaton*>(aut)->GetBase()),
           _guide(static_cast<ProjectionAutomaton*>(aut)->GetGuide()),
-          _searchType(search),
+          _searchType((TermFixpoint::bestFirstSearch && search == WorklistSearchType::DFS) ? WorklistSearchType::BEST_FIRST : search),
           _bValue(initbValue) {
 #   if (MEASURE_STATE_SPACE == true)
     ++TermFixpoint::instances;
 #   endif
+    if(Tracer::enabled) {
+        this->_traceStart = this->_traceLast = Tracer::Now();
+    }
+    this->_worklist.SetOwner(this);
+    this->_UpdateAccounting();
+    this->_LinkActive();
 
 #   if (ALT_SKIP_EMPTY_UNIVERSE == false)
     // Initialize the (counter)examples
@@ -471,10 +498,10 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr startingTerm, Symbol* symbol, b
                 if (this->_guide != nullptr) {
                     switch (this->_guide->GiveTip(startingTerm, symbol)) {
                         case GuideTip::G_FRONT:
-                            this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(startingTerm, symbol));
+                            this->_pushToWorklist(startingTerm, symbol);
                             break;
                         case GuideTip::G_BACK:
-                            this->_worklist.push_back(std::make_pair(startingTerm, symbol));
+                            this->_pushToWorklist(startingTerm, symbol, true);
                             break;
                         case GuideTip::G_THROW:
                             break;
@@ -482,16 +509,16 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr startingTerm, Symbol* symbol, b
                             assert(false && "Unsupported guiding tip\n");
                     }
                 } else {
-                    this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(startingTerm, symbol));
+                    this->_pushToWorklist(startingTerm, symbol);
                 }
 #               else
-                this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(startingTerm, symbol));
+                this->_pushToWorklist(startingTerm, symbol);
 #               endif
             }
 #       if (OPT_WORKLIST_DRIVEN_BY_RESTRICTIONS == true)
         } else {
             assert(tip == GuideTip::G_PROJECT_ALL);
-            this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(startingTerm, this->_projectedSymbol));
+            this->_pushToWorklist(startingTerm, this->_projectedSymbol);
         }
 #       endif
         assert(this->_worklist.size() > 0 || startingTerm->type == TermType::EMPTY);
@@ -525,12 +552,18 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr sourceTerm, Symbol* symbol, boo
           _guide(static_cast<ProjectionAutomaton*>(aut)->GetGuide()),
           _baseAut(static_cast<ProjectionAutomaton*>(aut)->GetBase()),
           _worklist(),
-          _searchType(WorklistSearchType::DFS),
+          _searchType(TermFixpoint::bestFirstSearch ? WorklistSearchType::BEST_FIRST : WorklistSearchType::DFS),
           _bValue(inComplement) {
 #   if (MEASURE_STATE_SPACE == true)
     ++TermFixpoint::instances;
     ++TermFixpoint::preInstances;
 #   endif
+    if(Tracer::enabled) {
+        this->_traceStart = this->_traceLast = Tracer::Now();
+    }
+    this->_worklist.SetOwner(this);
+    this->_UpdateAccounting();
+    this->_LinkActive();
     assert(sourceTerm->type == TermType::FIXPOINT && "Computing Pre fixpoint of something different than fixpoint");
 
     // Initialize the state space
@@ -553,6 +586,9 @@ TermFixpoint::TermFixpoint(Aut_ptr aut, Term_ptr sourceTerm, Symbol* symbol, boo
 }
 
 TermFixpoint::~TermFixpoint() {
+    this->_TraceSpan();
+    MemoryAccounting::Release(MemoryCategory::TERM_FIXPOINT, this->_accountedBytes);
+    this->_UnlinkActive();
     this->_fixpoint.clear();
 #   if (OPT_EARLY_EVALUATION == true)
     this->_postponed.clear();
@@ -570,10 +606,15 @@ void Term::Complement() {
  * @param[in]  term  term we are aliasing link with
  */
 void Term::SetSameSuccesorAs(Term* term) {
-    if(this->link->succ == nullptr) {
-        this->link->succ = term->link->succ;
-        this->link->symbol = term->link->symbol;
-        this->link->len = term->link->len;
+    if(!GET_HAS_SUCCESSOR(term)) {
+        return;
+    }
+    if(!GET_HAS_SUCCESSOR(this)) {
+        SET_HAS_SUCCESSOR(this);
+        this->len = term->len;
+    }
+    if(this->link == nullptr && term->link != nullptr) {
+        this->link = new link_t(term->link->succ, term->link->symbol);
     }
 }
 
@@ -585,10 +626,13 @@ void Term::SetSameSuccesorAs(Term* term) {
  * @param[in]  symb  symbol we were subtracting from the @p succ
  */
 void Term::SetSuccessor(Term* succ, Symbol* symb) {
-    if(this->link->succ == nullptr) {
-        this->link->succ = succ;
-        this->link->symbol = symb;
-        this->link->len = succ->link->len + 1;
+    if(!GET_HAS_SUCCESSOR(this)) {
+        SET_HAS_SUCCESSOR(this);
+        this->len = succ->len + 1;
+    }
+    // Terms of decide-only run get their links only when the witnesses are replayed
+    if(Term::witnessTracking && this->link == nullptr) {
+        this->link = new link_t(succ, symb);
     }
 }
 
@@ -976,6 +1020,29 @@ SubsumedType TermBaseSet::_IsSubsumedCore(Term *term, int limit, Term** new_term
     assert(term->type == TermType::BASE);
     TermBaseSet *t = static_cast<TermBaseSet*>(term);
 
+#   if (OPT_USE_BASE_SIMULATION == true)
+    if(this->_aut->type == AutType::BASE && static_cast<BaseAutomaton*>(this->_aut)->HasSimulation()) {
+        // Simulation-up-to inclusion, smaller sets can subsume the bigger ones
+        BaseAutomaton* base = static_cast<BaseAutomaton*>(this->_aut);
+#       if (OPT_SUBSUMPTION_INTERSECTION == true)
+        if(new_term != nullptr) {
+            TermBaseSetStates diff;
+            *new_term = nullptr;
+            if(base->IsSimulatedBy(this->states, t->states, &diff)) {
+                return SubsumedType::YES;
+            } else if(diff.size() == this->states.size()) {
+                return SubsumedType::NOT;
+            } else {
+                *new_term = this->_aut->_factory.CreateBaseSet(std::move(diff));
+                (*new_term)->SetSameSuccesorAs(this);
+                return SubsumedType::PARTIALLY;
+            }
+        }
+#       endif
+        return base->IsSimulatedBy(this->states, t->states) ? SubsumedType::YES : SubsumedType::NOT;
+    }
+#   endif
+
 #   if (OPT_SUBSUMPTION_INTERSECTION == true)
     if(new_term != nullptr) {
         TermBaseSetStates diff;
@@ -1130,11 +1197,33 @@ void prune_worklist(WorklistType& worklist, Term*& item) {
 }
 
 void switch_in_worklist(WorklistType& worklist, Term*& item, Term*& new_item) {
-    for(auto it = worklist.begin(); it != worklist.end(); ++it) {
-        if(it->first == item) {
-            it->first = new_item;
+    worklist.Switch(item, new_item);
+}
+
+/**
+ * Replaces the @p item by @p newItem in the queued pairs. Scored items are rescored by their owner and
+ * reinserted, so the best-first order does not go stale after the switch.
+ *
+ * @param[in]  item  switched term
+ * @param[in]  newItem  term that replaces the @p item
+ */
+void Worklist::Switch(Term_ptr item, Term_ptr newItem) {
+    Symbols rescored;
+    for(auto it = this->_items.begin(); it != this->_items.end();) {
+        if(it->first != item) {
+            ++it;
+        } else if(this->_heads.empty()) {
+            it->first = newItem;
+            ++it;
+        } else {
+            rescored.push_back(it->second);
+            it = this->erase(it);
         }
     }
+    assert(rescored.empty() || this->_owner != nullptr);
+    for(SymbolType* symbol : rescored) {
+        this->InsertScored(std::make_pair(newItem, symbol), TermFixpoint::worklistScore(this->_owner, newItem, symbol));
+    }
 }
 
 /**
@@ -1921,7 +2010,7 @@ bool TermFixpoint::_processOnePostponed() {
         // Push new symbols from _symList, if we are in Fixpoint semantics
         if (this->GetSemantics() == E_FIXTERM_FIXPOINT) {
             for (auto &symbol : this->_symList) {
-                this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(postponedTerm, symbol));
+                this->_pushToWorklist(postponedTerm, symbol);
             }
         }
         #if (MEASURE_POSTPONED == TRUE)
@@ -2030,35 +2119,208 @@ std::pair<SubsumedType, Term_ptr> TermFixpoint::_testIfSubsumes(Term_ptr const&
     #endif
 }
 
-WorklistItemType TermFixpoint::_popFromWorklist() {
+Worklist::Item TermFixpoint::_popFromWorklist() {
     assert(_worklist.size() > 0);
     if(this->_searchType != WorklistSearchType::BFS) {
-        WorklistItemType item = _worklist.front();
+        Worklist::Item item = _worklist.front();
         _worklist.pop_front();
         return item;
     } else {
-        WorklistItemType item = _worklist.back();
+        Worklist::Item item = _worklist.back();
         _worklist.pop_back();
         return item;
     }
 }
 
+/**
+ * Returns the @p item taken by _popFromWorklist() back to its place in the worklist, when its processing
+ * was stopped by the resource governor, so the interrupted fixpoint stays consistent.
+ *
+ * @param[in]  item  item popped from the worklist
+ */
+void TermFixpoint::_returnToWorklist(Worklist::Item const& item) {
+    if(this->_IsBestFirst()) {
+        this->_worklist.InsertScored(item, item.score);
+    } else if(this->_searchType == WorklistSearchType::BFS) {
+        this->_worklist.push_back(item);
+    } else {
+        this->_worklist.insert(this->_worklist.cbegin(), item);
+    }
+}
+
+/**
+ * Pushes the pair of @p term and @p symbol to the worklist. For best-first search (also used by the
+ * root search with --best-first) the worklist is kept ordered by the worklistScore (lower first),
+ * computed once for the pushed item, otherwise the item is pushed to the front (or to the back if
+ * @p back is set).
+ *
+ * @param[in]  term  term that will be processed
+ * @param[in]  symbol  symbol we will subtract from the @p term
+ * @param[in]  back  true if the item is pushed to the back of unordered worklist
+ */
+void TermFixpoint::_pushToWorklist(Term_ptr term, SymbolType* symbol, bool back) {
+    if(this->_IsBestFirst()) {
+        this->_worklist.InsertScored(std::make_pair(term, symbol), TermFixpoint::worklistScore(this, term, symbol));
+    } else if(back) {
+        this->_worklist.push_back(std::make_pair(term, symbol));
+    } else {
+        this->_worklist.insert(this->_worklist.cbegin(), std::make_pair(term, symbol));
+    }
+}
+
+/**
+ * Default score of the worklist items for best-first search. Prefers shorter witnesses and smaller
+ * terms; base sets whose intersection with initial states leads to the early termination of the
+ * fixpoint are scored only by the length of the witness.
+ *
+ * @param[in]  fixpoint  fixpoint whose worklist is scored
+ * @param[in]  term  term of the worklist item
+ * @param[in]  symbol  symbol of the worklist item
+ * @return  score of the item, lower scores are explored first
+ */
+size_t TermFixpoint::DefaultWorklistScore(TermFixpoint* fixpoint, Term_ptr term, SymbolType* symbol) {
+    size_t len = term->len;
+    if(term->type == TermType::BASE && fixpoint->_baseAut->type == AutType::BASE) {
+        TermBaseSet* initial = static_cast<TermBaseSet*>(fixpoint->_baseAut->GetInitialStates());
+        bool intersects = static_cast<TermBaseSet*>(term)->Intersects(initial);
+        if((intersects != static_cast<bool>(GET_NON_MEMBERSHIP_TESTING(fixpoint))) == fixpoint->_shortBoolValue) {
+            return len;
+        }
+    }
+    return len + term->stateSpaceApprox;
+}
+
+/**
+ * Counts the iteration of the fixpoint and periodically samples the sizes of caches to trace
+ */
+void TermFixpoint::_traceIteration() {
+    ++this->_iterations;
+    if(Tracer::enabled) {
+        this->_traceLast = Tracer::Now();
+        if((this->_iterations % OPT_TRACE_SAMPLE_PERIOD) == 0) {
+            this->_baseAut->TraceCacheSizes();
+        }
+    }
+}
+
+/**
+ * Updates the accounted footprint of the fixpoint by the current sizes of the fixpoint and worklist. The footprint
+ * is accounted in amortized steps, only once it doubles or halves since the last update.
+ */
+void TermFixpoint::_UpdateAccounting() {
+#   if (MEASURE_MEMORY == true)
+    const size_t nodeSize = 2*sizeof(void*);
+    size_t bytes = sizeof(TermFixpoint)
+        + this->_fixpoint.size()*(sizeof(FixpointMember) + nodeSize)
+        + this->_worklist.size()*(sizeof(Worklist::Item) + nodeSize);
+    if(bytes > 2*this->_accountedBytes || 2*bytes < this->_accountedBytes) {
+        MemoryAccounting::Resize(MemoryCategory::TERM_FIXPOINT, this->_accountedBytes, bytes);
+    }
+#   endif
+}
+
+/**
+ * Links the fixpoint to the list of active fixpoints, that is reported in the live statistics
+ */
+void TermFixpoint::_LinkActive() {
+    this->_nextActive = TermFixpoint::_activeHead;
+    if(TermFixpoint::_activeHead != nullptr) {
+        TermFixpoint::_activeHead->_prevActive = this;
+    }
+    TermFixpoint::_activeHead = this;
+    ++TermFixpoint::activeFixpoints;
+}
+
+void TermFixpoint::_UnlinkActive() {
+    if(this->_prevActive != nullptr) {
+        this->_prevActive->_nextActive = this->_nextActive;
+    } else {
+        TermFixpoint::_activeHead = this->_nextActive;
+    }
+    if(this->_nextActive != nullptr) {
+        this->_nextActive->_prevActive = this->_prevActive;
+    }
+    --TermFixpoint::activeFixpoints;
+}
+
+/**
+ * Traces the lifetime of the fixpoint from its creation to its last iteration. The span is emitted once, when
+ * the fixpoint is fully unfolded, destroyed, or still active at the closing of the tracer.
+ */
+void TermFixpoint::_TraceSpan() {
+    if(Tracer::enabled && !this->_traced) {
+        this->_traced = true;
+        Tracer::Span("fixpoint", (this->_sourceTerm == nullptr ? "fixpoint" : "pre"), this->_traceStart, this->_traceLast,
+                     "iterations", this->_iterations, "members", this->_fixpoint.size());
+    }
+}
+
+/**
+ * Traces the spans of the active fixpoints, that were not traced yet (called on the closing of the tracer)
+ */
+void TermFixpoint::TraceActive() {
+    for(TermFixpoint* fixpoint = TermFixpoint::_activeHead; fixpoint != nullptr; fixpoint = fixpoint->_nextActive) {
+        fixpoint->_TraceSpan();
+    }
+}
+
+/**
+ * Prints the overall sizes of the active fixpoints and worklists and the @p limit biggest fixpoints
+ *
+ * @param[in]  os  output stream
+ * @param[in]  limit  number of the biggest fixpoints that are printed
+ */
+void TermFixpoint::DumpActive(std::ostream& os, size_t limit) {
+    std::vector<TermFixpoint*> active;
+    active.reserve(TermFixpoint::activeFixpoints);
+    size_t members = 0, worklist = 0, computed = 0;
+    for(TermFixpoint* fixpoint = TermFixpoint::_activeHead; fixpoint != nullptr; fixpoint = fixpoint->_nextActive) {
+        active.push_back(fixpoint);
+        members += fixpoint->_fixpoint.size();
+        worklist += fixpoint->_worklist.size();
+        computed += fixpoint->_fullyComputed;
+    }
+    os << "\t\u2218 Active fixpoints: " << active.size() << " (" << computed << " fully computed), ";
+    os << members << " members, " << worklist << " items in worklists\n";
+
+    limit = std::min(limit, active.size());
+    std::partial_sort(active.begin(), active.begin() + limit, active.end(), [](TermFixpoint* lhs, TermFixpoint* rhs) {
+        return lhs->_fixpoint.size() > rhs->_fixpoint.size();
+    });
+    for(size_t i = 0; i < limit; ++i) {
+        os << "\t\t[" << active[i] << "] " << (active[i]->_sourceTerm == nullptr ? "fixpoint" : "pre");
+        os << ": " << active[i]->_fixpoint.size() << " members, " << active[i]->_worklist.size() << " in worklist, ";
+        os << active[i]->_iterations << " iterations\n";
+    }
+}
+
 /**
  * Does the computation of the next fixpoint, i.e. the next iteration.
  */
 void TermFixpoint::ComputeNextFixpoint() {
     if(_worklist.empty())
         return;
+    ResourceGovernor::Poll();
+    this->_traceIteration();
+    this->_UpdateAccounting();
 
     // Pop the front item from worklist
-    WorklistItemType item = this->_popFromWorklist();
-
-    // Compute the results
-    ResultType result = this->_baseAut->IntersectNonEmpty(item.second, item.first, GET_NON_MEMBERSHIP_TESTING(this));
+    Worklist::Item item = this->_popFromWorklist();
+
+    // Compute the results; the nested fixpoints can be stopped by the governor, before this one is changed
+    ResultType result;
+    std::pair<SubsumedType, Term_ptr> fix_result;
+    try {
+        result = this->_baseAut->IntersectNonEmpty(item.second, item.first, GET_NON_MEMBERSHIP_TESTING(this));
+        // If it is subsumed by fixpoint, we don't add it
+        fix_result = this->_fixpointTest(result.first);
+    } catch (const GastonResourceExhausted&) {
+        this->_returnToWorklist(item);
+        --this->_iterations;
+        throw;
+    }
     this->_updateExamples(result);
 
-    // If it is subsumed by fixpoint, we don't add it
-    auto fix_result = this->_fixpointTest(result.first);
     if(fix_result.first != SubsumedType::NOT) {
         assert(fix_result.first != SubsumedType::PARTIALLY);
 #       if (MEASURE_PROJECTION == true)
@@ -2101,13 +2363,13 @@ void TermFixpoint::ComputeNextFixpoint() {
 #                       if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
                         std::cout << "G_FRONT\n";
 #                       endif
-                        _worklist.insert(_worklist.cbegin(), std::make_pair(fix_result.second, symbol));
+                        this->_pushToWorklist(fix_result.second, symbol);
                         break;
                     case GuideTip::G_BACK:
 #                       if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
                         std::cout << "G_BACK\n";
 #                       endif
-                        _worklist.push_back(std::make_pair(fix_result.second, symbol));
+                        this->_pushToWorklist(fix_result.second, symbol, true);
                         break;
                     case GuideTip::G_THROW:
 #                       if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
@@ -2115,7 +2377,7 @@ void TermFixpoint::ComputeNextFixpoint() {
 #                       endif
                         break;
                     case GuideTip::G_PROJECT:
-                        _worklist.insert(_worklist.cbegin(), std::make_pair(fix_result.second, symbol));
+                        this->_pushToWorklist(fix_result.second, symbol);
                         break;
                     default:
                         assert(false && "Unsupported guide tip");
@@ -2124,23 +2386,23 @@ void TermFixpoint::ComputeNextFixpoint() {
 #               if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
                 std::cout << "insert\n";
 #               endif
-                _worklist.insert(_worklist.cbegin(), std::make_pair(fix_result.second, symbol));
+                this->_pushToWorklist(fix_result.second, symbol);
             }
 #           elif (OPT_FIXPOINT_BFS_SEARCH == true)
-            _worklist.push_back(std::make_pair(fix_result.second, symbol));
+            this->_pushToWorklist(fix_result.second, symbol, true);
 #          else
-            _worklist.insert(_worklist.cbegin(), std::make_pair(fix_result.second, symbol));
+            this->_pushToWorklist(fix_result.second, symbol);
 #           endif
         }
 #   if (OPT_WORKLIST_DRIVEN_BY_RESTRICTIONS == true)
     } else {
         assert(tip == GuideTip::G_PROJECT_ALL);
-        _worklist.insert(_worklist.cbegin(), std::make_pair(fix_result.second, this->_projectedSymbol));
+        this->_pushToWorklist(fix_result.second, this->_projectedSymbol);
     }
 #   endif
 
-    if(this->_aut->stats.max_symbol_path_len < fix_result.second->link->len) {
-        this->_aut->stats.max_symbol_path_len = fix_result.second->link->len;
+    if(this->_aut->stats.max_symbol_path_len < fix_result.second->len) {
+        this->_aut->stats.max_symbol_path_len = fix_result.second->len;
     }
 }
 
@@ -2151,16 +2413,27 @@ void TermFixpoint::ComputeNextFixpoint() {
 void TermFixpoint::ComputeNextPre() {
     if(_worklist.empty())
         return;
+    ResourceGovernor::Poll();
+    this->_traceIteration();
+    this->_UpdateAccounting();
 
     // Pop item from worklist
-    WorklistItemType item = this->_popFromWorklist();
-
-    // Compute the results
-    ResultType result = this->_baseAut->IntersectNonEmpty(item.second, item.first, GET_NON_MEMBERSHIP_TESTING(this));
+    Worklist::Item item = this->_popFromWorklist();
+
+    // Compute the results; the nested fixpoints can be stopped by the governor, before this one is changed
+    ResultType result;
+    std::pair<SubsumedType, Term_ptr> fix_result;
+    try {
+        result = this->_baseAut->IntersectNonEmpty(item.second, item.first, GET_NON_MEMBERSHIP_TESTING(this));
+        // If it is subsumed we return
+        fix_result = this->_fixpointTest(result.first);
+    } catch (const GastonResourceExhausted&) {
+        this->_returnToWorklist(item);
+        --this->_iterations;
+        throw;
+    }
     this->_updateExamples(result);
 
-    // If it is subsumed we return
-    auto fix_result = this->_fixpointTest(result.first);
     if(fix_result.first != SubsumedType::NOT) {
         assert(fix_result.first != SubsumedType::PARTIALLY);
         return;
@@ -2174,8 +2447,8 @@ void TermFixpoint::ComputeNextPre() {
         _fixpoint.push_back(std::make_pair(fix_result.second, true));
     }
 
-    if(this->_aut->stats.max_symbol_path_len < fix_result.second->link->len) {
-        this->_aut->stats.max_symbol_path_len = fix_result.second->link->len;
+    if(this->_aut->stats.max_symbol_path_len < fix_result.second->len) {
+        this->_aut->stats.max_symbol_path_len = fix_result.second->len;
     }
 
     _updated = true;
@@ -2255,7 +2528,8 @@ bool TermFixpoint::GetResult() {
 void TermFixpoint::_updateExamples(ResultType& result) {
     if(this->_searchType == WorklistSearchType::UNGROUND_ROOT) {
 #   if (ALT_SKIP_EMPTY_UNIVERSE == true)
-        if (result.first->link->symbol == nullptr)
+        // Note: during replay of witnesses the terms already have successors, but not the links
+        if (Term::witnessTracking ? result.first->link == nullptr : !result.first->HasSuccessor())
             return;
 #   endif
         if (result.second) {
@@ -2322,6 +2596,7 @@ FixpointSemanticType TermFixpoint::GetSemantics() const {
 // <<< ADDITIONAL TERMCONTINUATION FUNCTIONS >>>
 Term* TermContinuation::unfoldContinuation(UnfoldedIn t) {
     if(this->_unfoldedTerm == nullptr) {
+        Tracer::Scope traceScope("unfold continuation", "continuation");
         if(lazyEval) {
             assert(this->aut->aut->type == AutType::INTERSECTION || this->aut->aut->type == AutType::UNION);
             assert(this->initAut != nullptr);
@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <list>
+#include <map>
 #include <algorithm>
 #include "../environment.hh"
 #include "../mtbdd/ondriks_mtbdd.hh"
@@ -26,6 +27,7 @@
 #include "../containers/FixpointGuide.h"
 #include "../containers/TermEnumerator.h"
 #include "../containers/Workshops.h"
+#include "../utils/MemoryAccounting.h"
 
 // <<< MACROS >>>
 #define TERM_TYPELIST(code, var) \
@@ -71,9 +73,79 @@ using TermListType = std::list<std::pair<Term_ptr, Term_ptr>>;
 using Aut_ptr = SymbolicAutomaton*;
 
 using WorklistItemType = std::pair<Term_ptr, SymbolType*>;
-using WorklistType = std::list<WorklistItemType>;
 using Symbols = std::vector<SymbolType*>;
 
+/**
+ * Worklist of the fixpoint. Items inserted by InsertScored are kept ordered by their score (lower first),
+ * which is computed only once by the caller. Each score is indexed by the first of its items, so the scored
+ * insertion costs O(log s) for s distinct scores; the erasing functions keep the index consistent.
+ */
+class TermFixpoint;
+class Worklist {
+public:
+    struct Item : public WorklistItemType {
+        size_t score;
+        Item(WorklistItemType const& item, size_t s = 0) : WorklistItemType(item), score(s) {}
+    };
+    using iterator = std::list<Item>::iterator;
+    using const_iterator = std::list<Item>::const_iterator;
+
+private:
+    std::list<Item> _items;
+    std::map<size_t, iterator> _heads;      // < First item of each score (filled only by scored insertion)
+    TermFixpoint* _owner = nullptr;         // < Fixpoint that scores the items
+
+public:
+    void SetOwner(TermFixpoint* owner) { this->_owner = owner; }
+    void Switch(Term_ptr item, Term_ptr newItem);
+
+    iterator begin() { return this->_items.begin(); }
+    iterator end() { return this->_items.end(); }
+    const_iterator begin() const { return this->_items.begin(); }
+    const_iterator end() const { return this->_items.end(); }
+    const_iterator cbegin() const { return this->_items.cbegin(); }
+    size_t size() const { return this->_items.size(); }
+    bool empty() const { return this->_items.empty(); }
+    Item& front() { return this->_items.front(); }
+    Item& back() { return this->_items.back(); }
+
+    void push_back(WorklistItemType const& item) { this->_items.emplace_back(item); }
+    iterator insert(const_iterator pos, WorklistItemType const& item) { return this->_items.insert(pos, Item(item)); }
+    void pop_front() { this->erase(this->_items.begin()); }
+    void pop_back() { this->erase(std::prev(this->_items.end())); }
+    void clear() { this->_items.clear(); this->_heads.clear(); }
+
+    /**
+     * Inserts the @p item in front of the other items of the same @p score
+     */
+    void InsertScored(WorklistItemType const& item, size_t score) {
+        auto head = this->_heads.lower_bound(score);
+        iterator pos = (head == this->_heads.end() ? this->_items.end() : head->second);
+        iterator inserted = this->_items.insert(pos, Item(item, score));
+        if(head != this->_heads.end() && head->first == score) {
+            head->second = inserted;
+        } else {
+            this->_heads.emplace_hint(head, score, inserted);
+        }
+    }
+
+    iterator erase(iterator it) {
+        if(!this->_heads.empty()) {
+            auto head = this->_heads.find(it->score);
+            if(head != this->_heads.end() && head->second == it) {
+                iterator next = std::next(it);
+                if(next != this->_items.end() && next->score == it->score) {
+                    head->second = next;
+                } else {
+                    this->_heads.erase(head);
+                }
+            }
+        }
+        return this->_items.erase(it);
+    }
+};
+using WorklistType = Worklist;
+
 // <<< MACROS FOR ACCESS OF FLAGS >>>
 #   define GET_IN_COMPLEMENT(term) (term->_flags & (1 << 1))
 #   define SET_IN_COMPLEMENT(term) (term->_flags |= (1 << 1))
@@ -84,9 +156,12 @@ using Symbols = std::vector<SymbolType*>;
 #   define FLIP_NON_MEMBERSHIP_TESTING(term) (term->_flags ^= 1)
 #   define GET_PRODUCT_SUBTYPE(term) ( (term->_flags & (0b11 << 2)) >> 2)
 #   define SET_PRODUCT_SUBTYPE(term, pt) (term->_flags |= (static_cast<int>(pt)) << 2) // Note that we assign only once, so this should be ok
+#   define GET_HAS_SUCCESSOR(term) (term->_flags & (1 << 4))
+#   define SET_HAS_SUCCESSOR(term) (term->_flags |= (1 << 4))
 
 class Term {
     friend class Workshops::TermWorkshop;
+    friend class TermReclaimer;
 
     // <<< MEMBERS >>>
 protected:
@@ -95,19 +170,19 @@ protected:
     EnumSubsumesCache _subsumesCache;   // [36B] << Cache for results of subsumes
 #   endif
 public:
-    struct link_t {                        // [8B*3] << Link for counterexamples
+    struct link_t {                        // [8B*2] << Link for counterexamples
         Term* succ;
         Symbol* symbol;
-        size_t len;
 
-        link_t(Term* s, Symbol* sym, size_t l) : succ(s), symbol(sym), len(l) {}
+        link_t(Term* s, Symbol* sym) : succ(s), symbol(sym) {}
     };
 
-    link_t* link;
+    link_t* link = nullptr;         // [8B] << Formed lazily, only when tracking witnesses
+    size_t len = 0;                 // [4-8B] << Length of the successor path, used for heuristics
     size_t stateSpaceApprox = 0;    // [4-8B] << Approximation of the state space, used for heuristics
     TermType type;                  // [4B] << Type of the term
 protected:
-    char _flags = 0;                // [1B] << Flags with 0: nonMembership, 1: inComplement, 2-3: subtype
+    char _flags = 0;                // [1B] << Flags with 0: nonMembership, 1: inComplement, 2-3: subtype, 4: hasSuccessor
 public:
     NEVER_INLINE Term(Aut_ptr);
     virtual NEVER_INLINE ~Term();
@@ -115,6 +190,7 @@ public:
     // See #L29
     TERM_MEASURELIST(DEFINE_STATIC_MEASURE)
     static size_t partial_subsumption_hits;
+    static bool witnessTracking;    // < Links for the examples are formed (off in decide-only mode)
 
 public:
     // <<< PUBLIC API >>>
@@ -128,6 +204,7 @@ public:
     bool IsNotComputed();
     void SetSuccessor(Term*, Symbol*);
     void SetSameSuccesorAs(Term*);
+    bool HasSuccessor() { return GET_HAS_SUCCESSOR(this); }
 
     // <<< MEASURING FUNCTIONS >>>
     virtual unsigned int MeasureStateSpace();
@@ -167,7 +244,7 @@ public:
 
     // <<< CONSTRUCTORS >>>
     explicit NEVER_INLINE TermEmpty(Aut_ptr aut, bool inComplement=false);
-    NEVER_INLINE ~TermEmpty() {}
+    NEVER_INLINE ~TermEmpty() { MemoryAccounting::Release(MemoryCategory::TERM_EMPTY, sizeof(TermEmpty)); }
 
     // <<< PUBLIC API >>>
     SubsumedType IsSubsumedBy(FixpointType& fixpoint, WorklistType& worklist, Term*&, bool no_prune = false);
@@ -337,6 +414,7 @@ private:
  * Class that represents the postponed computation of the (non)membership testing
  */
 class TermContinuation : public Term {
+    friend class TermReclaimer;
 protected:
     Term* _unfoldedTerm = nullptr;      // [4B] << Unfolded term for optimizations
 public:
@@ -357,6 +435,7 @@ public:
 
     // <<< CONSTRUCTORS >>>
     NEVER_INLINE TermContinuation(Aut_ptr, SymLink*, SymbolicAutomaton*, Term*, SymbolType*, bool, bool lazy = false);
+    NEVER_INLINE ~TermContinuation() { MemoryAccounting::Release(MemoryCategory::TERM_CONTINUATION, sizeof(TermContinuation)); }
 
     // <<< PUBLIC API >>>
     SubsumedType IsSubsumedBy(FixpointType& fixpoint, WorklistType& worklist, Term*&, bool no_prune = false);
@@ -389,6 +468,7 @@ public:
 
     // <<< CONSTRUCTORS >>>
     NEVER_INLINE TermList(Aut_ptr, Term_ptr first, bool isCompl);
+    NEVER_INLINE ~TermList() { MemoryAccounting::Release(MemoryCategory::TERM_LIST, sizeof(TermList)); }
 
     // <<< PUBLIC API >>>
     SubsumedType IsSubsumedBy(FixpointType& fixpoint, WorklistType& worklist, Term*&, bool no_prune = false);
@@ -410,7 +490,11 @@ private:
  * Class representing the fixpoint computation (either classic or pre fixpoint computation)
  */
 class TermFixpoint : public Term {
+public:
+    using WorklistScoreType = size_t (*)(TermFixpoint*, Term_ptr, SymbolType*);
+
     friend class Workshops::TermWorkshop;
+    friend class TermReclaimer;
     // <<< MEMBERS >>>
 public:
     struct iterator {
@@ -457,6 +541,7 @@ public:
 #                       if (OPT_EARLY_EVALUATION == true)
                         if(_termFixpoint._postponed.empty()) {
                             // Nothing postponed, we are done
+                            _termFixpoint._TraceSpan();
                             return this->_Invalidate();
                         } else {
                             // Take something from the postponed shit
@@ -467,6 +552,7 @@ public:
                             }
                         }
 #                       else
+                        _termFixpoint._TraceSpan();
                         return this->_Invalidate();
 #                       endif
                     } else {
@@ -496,13 +582,13 @@ public:
 #                                           if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
                                             std::cout << "G_FRONT\n";
 #                                           endif
-                                            _termFixpoint._worklist.insert(_termFixpoint._worklist.cbegin(), std::make_pair(term, symbol));
+                                            _termFixpoint._pushToWorklist(term, symbol);
                                             break;
                                         case GuideTip::G_BACK:
 #                                           if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
                                             std::cout << "G_BACK\n";
 #                                           endif
-                                            _termFixpoint._worklist.push_back(std::make_pair(term, symbol));
+                                            _termFixpoint._pushToWorklist(term, symbol, true);
                                             break;
                                         case GuideTip::G_THROW:
 #                                           if (DEBUG_RESTRICTION_DRIVEN_FIX == true)
@@ -510,18 +596,18 @@ public:
 #                                           endif
                                             break;
                                         case GuideTip::G_PROJECT:
-                                            _termFixpoint._worklist.insert(_termFixpoint._worklist.cbegin(), std::make_pair(term, symbol));
+                                            _termFixpoint._pushToWorklist(term, symbol);
                                             break;
                                         default:
                                             assert(false && "Unsupported guide tip");
                                     }
                                 } else {
-                                    _termFixpoint._worklist.insert(_termFixpoint._worklist.cbegin(), std::make_pair(term, symbol));
+                                    _termFixpoint._pushToWorklist(term, symbol);
                                 }
 #                               elif (OPT_FIXPOINT_BFS_SEARCH == true)
-                                _termFixpoint._worklist.push_back(std::make_pair(term, symbol));
+                                _termFixpoint._pushToWorklist(term, symbol, true);
 #                               else
-                                _termFixpoint._worklist.insert(_termFixpoint._worklist.cbegin(), std::make_pair(term, symbol));
+                                _termFixpoint._pushToWorklist(term, symbol);
 #                               endif
                             }
                             _termFixpoint.ComputeNextPre();
@@ -536,6 +622,7 @@ public:
 #                           endif
 #                           if (OPT_EARLY_EVALUATION == true)
                             if(_termFixpoint._postponed.empty()) {
+                                _termFixpoint._TraceSpan();
                                 return this->_Invalidate();
                             } else {
                                 if(this->_termFixpoint._processOnePostponed()) {
@@ -545,6 +632,7 @@ public:
                                 }
                             }
 #                           else
+                            _termFixpoint._TraceSpan();
                             return this->_Invalidate();
 #                           endif
                         }
@@ -574,6 +662,14 @@ protected:
 #   endif
     WorklistType _worklist;                 // [8B] << Worklist of the fixpoint
     Symbols _symList;                       // [8B] << List of symbols
+    size_t _iterations = 0;                 // [4-8B] << Number of computed iterations
+    std::uint64_t _traceStart = 0;          // [8B] << Timestamp of the creation for tracing
+    std::uint64_t _traceLast = 0;           // [8B] << Timestamp of the last iteration for tracing
+    bool _traced = false;                   // [1B] << Whether the lifetime of the fixpoint was traced
+    size_t _accountedBytes = 0;             // [4-8B] << Footprint accounted to the memory accounting
+    TermFixpoint* _prevActive = nullptr;    // [4-8B] << Previous fixpoint in the list of active fixpoints
+    TermFixpoint* _nextActive = nullptr;    // [4-8B] << Next fixpoint in the list of active fixpoints
+    static TermFixpoint* _activeHead;       // << Head of the list of active (not destroyed) fixpoints
     size_t _iteratorNumber = 0;             // [4-8B] << How many iterators are pointing to fixpoint
     Symbol_ptr _projectedSymbol;            // [4B] << Source symbol with projected vars
     Aut_ptr _baseAut;
@@ -598,6 +694,9 @@ public:
     static size_t postponedTerms;
     static size_t postponedProcessed;
     static size_t fullyComputedFixpoints;
+    static size_t activeFixpoints;
+    static WorklistScoreType worklistScore;
+    static bool bestFirstSearch;            // < Worklists (including the root search) are ordered by the worklistScore
 
     // <<< CONSTRUCTORS >>>
     NEVER_INLINE TermFixpoint(Aut_ptr aut, Term_ptr startingTerm, Symbol* startingSymbol, bool inComplement, bool initbValue, WorklistSearchType search);
@@ -621,6 +720,9 @@ public:
     unsigned int ValidMemberSize() const;
     bool HasEmptyWorklist() { return this->_worklist.empty();}
     void RemoveSubsumed();
+    static size_t DefaultWorklistScore(TermFixpoint*, Term_ptr, SymbolType*);
+    static void DumpActive(std::ostream&, size_t);
+    static void TraceActive();
     bool TestAndSetUpdate() {
         bool updated = this->_updated;
         this->_updated = false;
@@ -653,7 +755,18 @@ protected:
     std::pair<SubsumedType , Term_ptr> _testIfSmallerExists(Term_ptr const& term);
     bool _eqCore(const Term&);
     unsigned int _MeasureStateSpaceCore();
-    WorklistItemType _popFromWorklist();
+    Worklist::Item _popFromWorklist();
+    void _returnToWorklist(Worklist::Item const&);
+    void _traceIteration();
+    void _UpdateAccounting();
+    void _LinkActive();
+    void _UnlinkActive();
+    void _TraceSpan();
+    void _pushToWorklist(Term_ptr, SymbolType*, bool back = false);
+    bool _IsBestFirst() const {
+        return this->_searchType == WorklistSearchType::BEST_FIRST
+               || (this->_searchType == WorklistSearchType::UNGROUND_ROOT && TermFixpoint::bestFirstSearch);
+    }
 };
 
 #undef DEFINE_STATIC_MEASURE
@@ -0,0 +1,229 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Reclamation of the unreachable terms
+ *****************************************************************************/
+
+#include "TermReclaimer.h"
+#include "Term.h"
+#include "SymbolicAutomata.h"
+#include "Workshops.h"
+#include "../utils/MemoryAccounting.h"
+#include "../utils/Tracer.h"
+#include <algorithm>
+#include <functional>
+
+size_t TermReclaimer::collections = 0;
+size_t TermReclaimer::reclaimed = 0;
+size_t TermReclaimer::reclaimedBytes = 0;
+size_t TermReclaimer::_liveAfterLast = 0;
+std::vector<SymbolicAutomaton*> TermReclaimer::retainedRoots;
+
+/**
+ * @return  true if the accounted memory grew enough since the last collection
+ */
+bool TermReclaimer::ShouldCollect() {
+    size_t live = MemoryAccounting::GetLiveTotal();
+    return live >= OPT_RECLAIM_MIN_BYTES && live >= OPT_RECLAIM_GROWTH_FACTOR*TermReclaimer::_liveAfterLast;
+}
+
+/**
+ * Reclaims all of the terms that are not reachable from the @p roots or automata reachable from the @p root.
+ * Has to be called at the point, where no other terms are held on the stack.
+ *
+ * @param[in]  root  root of the symbolic automaton
+ * @param[in]  roots  terms held by the caller
+ * @return  number of destroyed terms
+ */
+size_t TermReclaimer::Collect(SymbolicAutomaton* root, std::initializer_list<Term*> roots) {
+    Tracer::Scope traceScope("reclaim terms", "reclaimer");
+    TermReclaimer reclaimer;
+    size_t before = TermReclaimer::reclaimed;
+    size_t liveBefore = MemoryAccounting::GetLiveTotal();
+
+    // Fixpoints without iterators can drop their subsumed members right away
+    for(TermFixpoint* fixpoint = TermFixpoint::_activeHead; fixpoint != nullptr; fixpoint = fixpoint->_nextActive) {
+        fixpoint->RemoveSubsumed();
+    }
+
+    reclaimer._CollectNodes(root);
+    reclaimer._MarkRoots(roots);
+    reclaimer._PurgeAndDestroy();
+
+    ++TermReclaimer::collections;
+    TermReclaimer::_liveAfterLast = MemoryAccounting::GetLiveTotal();
+    if(liveBefore > TermReclaimer::_liveAfterLast) {
+        TermReclaimer::reclaimedBytes += liveBefore - TermReclaimer::_liveAfterLast;
+    }
+    return TermReclaimer::reclaimed - before;
+}
+
+void TermReclaimer::_Mark(Term* term) {
+    if(term != nullptr && this->_live.insert(term).second) {
+        this->_stack.push_back(term);
+    }
+}
+
+/**
+ * Marks all of the terms reachable from the already marked terms
+ */
+void TermReclaimer::_Propagate() {
+    while(!this->_stack.empty()) {
+        Term* term = this->_stack.back();
+        this->_stack.pop_back();
+
+        // Successors are needed for the counterexamples
+        if(term->link != nullptr) {
+            this->_Mark(term->link->succ);
+        }
+        switch(term->type) {
+            case TermType::PRODUCT: {
+                TermProduct* product = static_cast<TermProduct*>(term);
+                this->_Mark(product->left);
+                this->_Mark(product->right);
+                break;
+            }
+            case TermType::TERNARY_PRODUCT: {
+                TermTernaryProduct* product = static_cast<TermTernaryProduct*>(term);
+                this->_Mark(product->left);
+                this->_Mark(product->middle);
+                this->_Mark(product->right);
+                break;
+            }
+            case TermType::NARY_PRODUCT: {
+                TermNaryProduct* product = static_cast<TermNaryProduct*>(term);
+                for(size_t i = 0; i < product->arity; ++i) {
+                    this->_Mark(product->terms[i]);
+                }
+                break;
+            }
+            case TermType::LIST:
+                for(auto& item : static_cast<TermList*>(term)->list) {
+                    this->_Mark(item);
+                }
+                break;
+            case TermType::CONTINUATION: {
+                TermContinuation* continuation = static_cast<TermContinuation*>(term);
+                this->_Mark(continuation->term);
+                this->_Mark(continuation->_unfoldedTerm);
+                break;
+            }
+            case TermType::FIXPOINT: {
+                TermFixpoint* fixpoint = static_cast<TermFixpoint*>(term);
+                for(auto& member : fixpoint->_fixpoint) {
+                    this->_Mark(member.first);
+                }
+                for(auto& item : fixpoint->_worklist) {
+                    this->_Mark(item.first);
+                }
+#               if (OPT_EARLY_EVALUATION == true)
+                for(auto& postponed : fixpoint->_postponed) {
+                    this->_Mark(postponed.first);
+                    this->_Mark(postponed.second);
+                }
+#               endif
+                this->_Mark(fixpoint->_sourceTerm);
+                this->_Mark(fixpoint->_satTerm);
+                this->_Mark(fixpoint->_unsatTerm);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+/**
+ * Collects all of the automata reachable from the @p root or from the retained roots
+ */
+void TermReclaimer::_CollectNodes(SymbolicAutomaton* root) {
+    std::unordered_set<SymbolicAutomaton*> visited;
+    std::vector<SymbolicAutomaton*> worklist(TermReclaimer::retainedRoots);
+    worklist.push_back(root);
+    while(!worklist.empty()) {
+        SymbolicAutomaton* node = worklist.back();
+        worklist.pop_back();
+        if(node != nullptr && visited.insert(node).second) {
+            this->_nodes.push_back(node);
+            node->GetSubautomata(worklist);
+        }
+    }
+}
+
+/**
+ * Marks the terms reachable from the @p roots, unique empty terms and states and examples of the automata.
+ * Fixpoints are marked only through these, so the fixpoints that are referenced solely by the result caches
+ * (e.g. the subsumed or already explored ones) are reclaimed together with the cache entries.
+ */
+void TermReclaimer::_MarkRoots(std::initializer_list<Term*> roots) {
+    for(Term* term : roots) {
+        this->_Mark(term);
+    }
+    this->_Mark(Workshops::TermWorkshop::CreateEmpty());
+    this->_Mark(Workshops::TermWorkshop::CreateComplementedEmpty());
+    for(SymbolicAutomaton* node : this->_nodes) {
+        this->_Mark(node->_initialStates);
+        this->_Mark(node->_finalStates);
+        this->_Mark(node->_satExample);
+        this->_Mark(node->_unsatExample);
+    }
+    this->_Propagate();
+}
+
+/**
+ * Purges all cache entries that mention some unmarked term and then destroys the unmarked terms
+ */
+void TermReclaimer::_PurgeAndDestroy() {
+    std::function<bool(Term*)> isDead = [this](Term* term) {
+        return term != nullptr && this->_live.find(term) == this->_live.end();
+    };
+
+    std::vector<Term*> dead;
+    for(SymbolicAutomaton* node : this->_nodes) {
+        node->_resCache.EraseIf([&isDead](ResultKey const& key, ResultType const& result) {
+            return isDead(key.first) || isDead(result.first);
+        });
+        node->_subCache.EraseIf([&isDead](SubsumptionKey const& key, SubsumptionResultPair const& result) {
+            return isDead(key.first) || isDead(key.second) || isDead(result.second);
+        });
+        if(node->type == AutType::BASE) {
+            BaseAutomaton* base = static_cast<BaseAutomaton*>(node);
+#           if (OPT_USE_SET_PRE == true)
+            base->_setCache.EraseIf([&isDead](SetPreKey const&, Term_ptr const& result) {
+                return isDead(result);
+            });
+#           else
+            base->_preCache.EraseIf([&isDead](PreKey const&, Term_ptr const& result) {
+                return isDead(result);
+            });
+#           endif
+        }
+        node->_factory.PurgeDead(this->_live, dead);
+    }
+    for(TermFixpoint* fixpoint = TermFixpoint::_activeHead; fixpoint != nullptr; fixpoint = fixpoint->_nextActive) {
+        if(!isDead(fixpoint)) {
+            fixpoint->_subsumedByCache.EraseIf([&isDead](Term* const& key, SubsumedType const&) {
+                return isDead(key);
+            });
+        }
+    }
+
+    // Pools free the chunks in the ordered manner, freeing from the highest address keeps it cheap
+    std::sort(dead.begin(), dead.end(), std::greater<Term*>());
+    dead.erase(std::unique(dead.begin(), dead.end()), dead.end());
+    for(Term* term : dead) {
+        Workshops::TermWorkshop::DestroyTerm(term);
+    }
+    TermReclaimer::reclaimed += dead.size();
+}
@@ -0,0 +1,73 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: TermReclaimer.h
+ *  Description:
+ *      Reclamation of the terms that are no longer reachable. Terms are
+ *      otherwise kept until their workshop is destroyed, since they are keys
+ *      of the unique tables and caches. The reclaimer marks the terms that
+ *      are reachable from the given roots and states and examples of the
+ *      automata, i.e. fixpoints (with their worklists) are live only if they
+ *      are reachable from these. Result caches are not roots, their entries
+ *      are only memoized queries that can be recomputed. Then it purges all
+ *      of the cache entries mentioning some unmarked term and destroys the
+ *      unmarked terms.
+ *
+ *      The collection has to run at the quiescent point, where no terms are
+ *      held on the stack, except for the explicitly given roots. Such point
+ *      is the iteration of the root fixpoint (see RootProjectionAutomaton).
+ *****************************************************************************/
+
+#ifndef WSKS_TERMRECLAIMER_H
+#define WSKS_TERMRECLAIMER_H
+
+#include <initializer_list>
+#include <unordered_set>
+#include <vector>
+#include "../environment.hh"
+
+#if (OPT_RECLAIM_DEAD_TERMS == true && (OPT_USE_DENSE_HASHMAP == true || OPT_ENUMERATED_SUBSUMPTION_TESTING == true))
+#   error "Reclamation of terms is not supported with dense hash maps or enumerated subsumption testing"
+#endif
+#if (OPT_RECLAIM_DEAD_TERMS == true && MEASURE_MEMORY == false)
+#   error "Reclamation of terms is scheduled by the memory accounting (MEASURE_MEMORY)"
+#endif
+
+class Term;
+class SymbolicAutomaton;
+
+class TermReclaimer {
+private:
+    std::unordered_set<Term*> _live;                // < Marked terms
+    std::vector<Term*> _stack;                      // < Marked terms with unprocessed successors
+    std::vector<SymbolicAutomaton*> _nodes;         // < Automata reachable from the root
+
+    static size_t _liveAfterLast;                   // < Accounted bytes after the last collection
+
+    void _Mark(Term*);
+    void _Propagate();
+    void _CollectNodes(SymbolicAutomaton*);
+    void _MarkRoots(std::initializer_list<Term*>);
+    void _PurgeAndDestroy();
+
+public:
+    static size_t collections;                      // < Number of the collections
+    static size_t reclaimed;                        // < Number of destroyed terms
+    static size_t reclaimedBytes;                   // < Accounted bytes freed by the collections
+    static std::vector<SymbolicAutomaton*> retainedRoots;   // < Roots of automata kept for later checks
+
+    static bool ShouldCollect();
+    static size_t Collect(SymbolicAutomaton* root, std::initializer_list<Term*> roots);
+};
+
+#endif //WSKS_TERMRECLAIMER_H
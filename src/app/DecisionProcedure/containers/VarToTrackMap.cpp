@@ -12,7 +12,9 @@
 #include "../../Frontend/symboltable.h"
 #include "../../Frontend/offsets.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 extern SymbolTable symbolTable;
 extern Offsets offsets;
@@ -26,10 +28,13 @@ extern Ident allPosVar;
  * Adds variables from list to the map
  *
  * @param identifiers: list of variables
+ * @param keepOrder: tracks are assigned in the order of the list instead of the order of identifiers
  */
-void VarToTrackMap::addIdentifiers(IdentList* identifiers) {
+void VarToTrackMap::addIdentifiers(IdentList* identifiers, bool keepOrder) {
 	uint identSize = identifiers->size();
-	identifiers->sort();
+	if(!keepOrder) {
+		identifiers->sort();
+	}
 
 	size_t idx = 0;
 	Ident formal;
@@ -66,6 +71,7 @@ void VarToTrackMap::addIdentifiers(IdentList* identifiers) {
 		(this->vttMap)[val] = idx;
 		(this->ttvMap)[idx++] = val;
 	}
+	this->AlignOffsets();
 
 #   if(DEBUG_VARMAP == true)
 	std::cout << "[*] Initialized VarMap\n";
@@ -101,6 +107,35 @@ uint VarToTrackMap::inverseGet(uint key) {
 	return this->ttvMap[key];
 }
 
+/**
+ * @param[in] offset: BDD index of the variable in MONA automata
+ * @return: track number associated to the variable with offset
+ */
+uint VarToTrackMap::TrackOfOffset(uint offset) {
+	assert(this->ottMap.find(offset) != this->ottMap.end());
+	return this->ottMap[offset];
+}
+
+/**
+ * Permutes the MONA offsets of the mapped variables, so the BDD indices of
+ * MONA automata are ordered the same way as the tracks. With tracks assigned
+ * in the order of identifiers the offsets are left as they are.
+ */
+void VarToTrackMap::AlignOffsets() {
+	std::vector<int> offs;
+	for (auto it = this->ttvMap.begin(); it != this->ttvMap.end(); ++it) {
+		offs.push_back(offsets.off(it->second));
+	}
+	std::sort(offs.begin(), offs.end());
+
+	this->ottMap.clear();
+	size_t i = 0;
+	for (auto it = this->ttvMap.begin(); it != this->ttvMap.end(); ++it, ++i) {
+		offsets.set(it->second, offs[i]);
+		(this->ottMap)[offs[i]] = it->first;
+	}
+}
+
 /**
  * Prints var -> trackNo map
  */
@@ -115,9 +150,30 @@ void VarToTrackMap::dumpMap() {
  * variables
  *
  * @param usedVar: list of variables used for track
+ * @param keepOrder: tracks are assigned in the order of @p usedVar
+ */
+void VarToTrackMap::initializeFromList(IdentList* usedVar, bool keepOrder) {
+	this->addIdentifiers(usedVar, keepOrder);
+}
+
+/**
+ * Removes all of the mapped variables, so the tracks can be assigned again
+ */
+void VarToTrackMap::clear() {
+	this->vttMap.clear();
+	this->ttvMap.clear();
+	this->ottMap.clear();
+}
+
+/**
+ * Maps the variable to the given track directly (used by the formula bundles)
+ *
+ * @param var: variable that is mapped
+ * @param track: track of the variable
  */
-void VarToTrackMap::initializeFromList(IdentList* usedVar) {
-	this->addIdentifiers(usedVar);
+void VarToTrackMap::insert(uint var, uint track) {
+	(this->vttMap)[var] = track;
+	(this->ttvMap)[track] = var;
 }
 
 /**
@@ -126,6 +182,6 @@ void VarToTrackMap::initializeFromList(IdentList* usedVar) {
  */
 void VarToTrackMap::initializeFromLists(IdentList* prefixVars, IdentList* matrixVars) {
 	assert(false);
-	this->addIdentifiers(prefixVars);
-	this->addIdentifiers(matrixVars);
+	this->addIdentifiers(prefixVars, false);
+	this->addIdentifiers(matrixVars, false);
 }
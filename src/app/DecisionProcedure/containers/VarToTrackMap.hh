@@ -25,21 +25,26 @@ private:
 	// < Private Members >
 	varMap vttMap;
 	varMap ttvMap;
+	varMap ottMap;
 
 	// < Private Methods >
-	void addIdentifiers(IdentList* );
+	void addIdentifiers(IdentList*, bool);
 
 public:
 	// < Public Methods >
 	uint TrackLength();
 	uint operator[](uint);
 	uint inverseGet(uint);
+	uint TrackOfOffset(uint);
 	void dumpMap();
 	bool IsIn(uint);
 
 	VarToTrackMap() : vttMap() {};
 
-	void initializeFromList(IdentList*);
+	void initializeFromList(IdentList*, bool keepOrder = false);
+	void clear();
+	void insert(uint, uint);
+	void AlignOffsets();
 	void initializeFromLists(IdentList*, IdentList*);
 };
 
@@ -7,7 +7,7 @@ extern VarToTrackMap varMap;
 
 namespace Workshops {
     NEVER_INLINE TermWorkshop::TermWorkshop(SymbolicAutomaton* aut) :
-            _bCache(nullptr), _ubCache(nullptr), _pCache(nullptr), _tpCache(nullptr), _npCache(nullptr), _lCache(nullptr),
+            _bCache(nullptr), _simCache(nullptr), _ubCache(nullptr), _pCache(nullptr), _tpCache(nullptr), _npCache(nullptr), _lCache(nullptr),
             _fpCache(nullptr), _fppCache(nullptr), _contCache(nullptr),_compCache(nullptr), _aut(aut) { }
 
     template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&)>
@@ -26,6 +26,7 @@ namespace Workshops {
 
     NEVER_INLINE TermWorkshop::~TermWorkshop() {
         this->_bCache = TermWorkshop::_cleanCache(this->_bCache, OPT_USE_BOOST_POOL_FOR_ALLOC);
+        this->_simCache = TermWorkshop::_cleanCache(this->_simCache, true);
         this->_ubCache = TermWorkshop::_cleanCache(this->_ubCache, true);
         this->_fpCache = TermWorkshop::_cleanCache(this->_fpCache, OPT_USE_BOOST_POOL_FOR_ALLOC);
         this->_fppCache = TermWorkshop::_cleanCache(this->_fppCache, OPT_USE_BOOST_POOL_FOR_ALLOC);
@@ -78,6 +79,9 @@ namespace Workshops {
         switch(this->_aut->type) {
             case AutType::BASE:
                 this->_bCache = new BaseCache();
+#               if (OPT_USE_BASE_SIMULATION == true)
+                this->_simCache = new BaseCache();
+#               endif
                 this->_ubCache = new ProductCache();
                 break;
             case AutType::BINARY:
@@ -163,25 +167,53 @@ namespace Workshops {
             }
 
             Term* termPtr = nullptr;
-            if(!this->_bCache->retrieveFromCache(states, termPtr)) {
-#               if (DEBUG_WORKSHOPS == true && DEBUG_TERM_CREATION == true)
-                std::cout << "[*] Creating BaseSet: ";
-#               endif
-                // The object was not created yet, so we create it and store it in cache
-#               if (OPT_USE_BOOST_POOL_FOR_ALLOC == true)
-                termPtr = TermWorkshop::_basePool.construct(this->_aut, states);
-#               else
-                termPtr = new TermBaseSet(this->_aut, std::move(states));
-#               endif
-                this->_bCache->StoreIn(states, termPtr);
+            if(this->_bCache->retrieveFromCache(states, termPtr)) {
+                return termPtr;
             }
-            assert(termPtr != nullptr);
-            return termPtr;
+#           if (OPT_USE_BASE_SIMULATION == true)
+            // Base sets are kept as the representatives that are not simulated by other states. The sets are
+            //   pruned only when missed, the pruned ones are remembered with their representatives.
+            if(this->_simCache != nullptr && static_cast<BaseAutomaton*>(this->_aut)->HasSimulation()) {
+                if(this->_simCache->retrieveFromCache(states, termPtr)) {
+                    return termPtr;
+                }
+                BaseKey unpruned(states);
+                static_cast<BaseAutomaton*>(this->_aut)->PruneSimulated(states);
+                if(states.size() != unpruned.size()) {
+                    if(!this->_bCache->retrieveFromCache(states, termPtr)) {
+                        termPtr = this->_CreateUniqueBaseSet(std::move(states));
+                    }
+                    this->_simCache->StoreIn(unpruned, termPtr);
+                    return termPtr;
+                }
+            }
+#           endif
+            return this->_CreateUniqueBaseSet(std::move(states));
 #       else
             return new TermBaseSet(states;
 #       endif
     }
 
+    /**
+     * Creates the base set of @p states, that is not in the base cache yet, and stores it there
+     *
+     * @param[in] states:  states of the created base set
+     * @return  created base set
+     */
+    Term* TermWorkshop::_CreateUniqueBaseSet(VATA::Util::OrdVector<size_t> && states) {
+#       if (DEBUG_WORKSHOPS == true && DEBUG_TERM_CREATION == true)
+        std::cout << "[*] Creating BaseSet: ";
+#       endif
+#       if (OPT_USE_BOOST_POOL_FOR_ALLOC == true)
+        Term* termPtr = TermWorkshop::_basePool.construct(this->_aut, states);
+#       else
+        Term* termPtr = new TermBaseSet(this->_aut, std::move(states));
+#       endif
+        this->_bCache->StoreIn(states, termPtr);
+        assert(termPtr != nullptr);
+        return termPtr;
+    }
+
     Term* TermWorkshop::CreateUnionBaseSet(const Term_ptr& lhs, const Term_ptr& rhs) {
         if(lhs == nullptr) {
             return rhs;
@@ -192,13 +224,31 @@ namespace Workshops {
         } else if(rhs->type == TermType::EMPTY) {
             return lhs;
         } else {
-            Term_ptr result;
+            Term_ptr result = nullptr;
             auto key = std::make_pair(lhs, rhs);
-            if(!this->_ubCache->retrieveFromCache(key, result)) {
-                TermBaseSet* llhs = static_cast<TermBaseSet*>(lhs);
-                result = this->CreateBaseSet(llhs->states.Union(static_cast<TermBaseSet*>(rhs)->states));
-                this->_ubCache->StoreIn(key, result);
+            if(this->_ubCache->retrieveFromCache(key, result)) {
+                return result;
+            }
+
+            TermBaseSet* llhs = static_cast<TermBaseSet*>(lhs);
+            TermBaseSet* rrhs = static_cast<TermBaseSet*>(rhs);
+#           if (OPT_USE_BASE_SIMULATION == true)
+            // Union with the set simulated by the other one is the other set; checked only on the miss
+            BaseAutomaton* base = static_cast<BaseAutomaton*>(this->_aut);
+            if(this->_aut->type == AutType::BASE && base->HasSimulation()) {
+                if(base->IsSimulatedBy(llhs->states, rrhs->states)) {
+                    result = rhs;
+                } else if(base->IsSimulatedBy(rrhs->states, llhs->states)) {
+                    result = lhs;
+                }
+            }
+            if(result == nullptr) {
+                result = this->CreateBaseSet(llhs->states.Union(rrhs->states));
             }
+#           else
+            result = this->CreateBaseSet(llhs->states.Union(rrhs->states));
+#           endif
+            this->_ubCache->StoreIn(key, result);
             return result;
         }
     }
@@ -445,6 +495,135 @@ namespace Workshops {
         #endif
     }
 
+    /**
+     * Purges the entries of all caches that mention some term that is not in @p live. The dead terms that
+     * are owned by this workshop are pushed to @p dead. Note that the terms have to be destroyed only after
+     * all of the caches were purged, as hashing of the keys can dereference them.
+     *
+     * @param[in] live:     set of the live terms
+     * @param[out] dead:    dead terms created by this workshop
+     */
+    void TermWorkshop::PurgeDead(std::unordered_set<Term*> const& live, std::vector<Term*>& dead) {
+        auto isDead = [&live](Term* term) {
+            return term != nullptr && live.find(term) == live.end();
+        };
+        // Caches that own their values, i.e. each created term is the value of exactly one entry
+        auto purgeOwned = [&isDead, &dead](Term* value, bool keyDead) {
+            if(isDead(value)) {
+                dead.push_back(value);
+                return true;
+            }
+            return keyDead;
+        };
+
+        if(this->_bCache != nullptr) {
+            this->_bCache->EraseIf([&](BaseKey const&, CacheData const& value) {
+                return purgeOwned(value, false);
+            });
+        }
+        if(this->_simCache != nullptr) {
+            // Representatives are owned by the base cache
+            this->_simCache->EraseIf([&](BaseKey const&, CacheData const& value) {
+                return isDead(value);
+            });
+        }
+        if(this->_ubCache != nullptr) {
+            this->_ubCache->EraseIf([&](ProductKey const& key, CacheData const& value) {
+                return isDead(key.first) || isDead(key.second) || isDead(value);
+            });
+        }
+        if(this->_pCache != nullptr) {
+            this->_pCache->EraseIf([&](ProductKey const& key, CacheData const& value) {
+                return purgeOwned(value, isDead(key.first) || isDead(key.second));
+            });
+        }
+        if(this->_tpCache != nullptr) {
+            this->_tpCache->EraseIf([&](TernaryKey const& key, CacheData const& value) {
+                return purgeOwned(value, isDead(std::get<0>(key)) || isDead(std::get<1>(key)) || isDead(std::get<2>(key)));
+            });
+        }
+        if(this->_npCache != nullptr) {
+            // Keys of nary products are the arrays of the products themselves
+            this->_npCache->EraseIf([&](NaryKey const&, CacheData const& value) {
+                return purgeOwned(value, false);
+            });
+        }
+        if(this->_lCache != nullptr) {
+            this->_lCache->EraseIf([&](ListKey const& key, CacheData const& value) {
+                return purgeOwned(value, isDead(key));
+            });
+        }
+        if(this->_fpCache != nullptr) {
+            this->_fpCache->EraseIf([&](ListKey const& key, CacheData const& value) {
+                return purgeOwned(value, isDead(key));
+            });
+        }
+        if(this->_fppCache != nullptr) {
+            this->_fppCache->EraseIf([&](FixpointKey const& key, CacheData const& value) {
+                return purgeOwned(value, isDead(key.first));
+            });
+        }
+        if(this->_contCache != nullptr) {
+            this->_contCache->EraseIf([&](FixpointKey const& key, CacheData const& value) {
+                return purgeOwned(value, isDead(key.first));
+            });
+        }
+        if(this->_compCache != nullptr) {
+            this->_compCache->EraseIf([&](ComputationKey const& key, CacheData const& value) {
+                return isDead(key) || isDead(value);
+            });
+        }
+    }
+
+    /**
+     * Destroys the @p term created by some workshop, i.e. returns it to its pool
+     *
+     * @param[in] term:     destroyed term
+     */
+    void TermWorkshop::DestroyTerm(Term* term) {
+        switch(term->type) {
+#           if (OPT_USE_BOOST_POOL_FOR_ALLOC == true)
+            case TermType::BASE:
+                TermWorkshop::_basePool.destroy(static_cast<TermBaseSet*>(term));
+                break;
+            case TermType::PRODUCT:
+                TermWorkshop::_productPool.destroy(static_cast<TermProduct*>(term));
+                break;
+            case TermType::TERNARY_PRODUCT:
+                TermWorkshop::_ternaryProductPool.destroy(static_cast<TermTernaryProduct*>(term));
+                break;
+            case TermType::NARY_PRODUCT:
+                TermWorkshop::_naryProductPool.destroy(static_cast<TermNaryProduct*>(term));
+                break;
+            case TermType::FIXPOINT:
+                TermWorkshop::_fixpointPool.destroy(static_cast<TermFixpoint*>(term));
+                break;
+#           endif
+            case TermType::EMPTY:
+                assert(false && "Empty terms are unique through the whole program");
+                break;
+            default:
+                delete term;
+                break;
+        }
+    }
+
+    /**
+     * Removes the @p fixpoint from the unique table and destroys it, so the next fixpoint created from
+     * the same source is computed anew
+     *
+     * @param[in] fixpoint:     destroyed fixpoint
+     */
+    void TermWorkshop::DestroyFixpoint(TermFixpoint* fixpoint) {
+#       if (OPT_GENERATE_UNIQUE_TERMS == true && UNIQUE_FIXPOINTS == true)
+        assert(this->_fpCache != nullptr);
+        this->_fpCache->EraseIf([fixpoint](Term_ptr const&, Term* const& term) {
+            return term == fixpoint;
+        });
+#       endif
+        TermWorkshop::DestroyTerm(fixpoint);
+    }
+
     /***
      * Dump stats for Workshop. Dumps the cache if it is created.
      */
@@ -453,6 +632,10 @@ namespace Workshops {
             std::cout << "  \u2218 BaseCache stats -> ";
             this->_bCache->dumpStats();
         }
+        if(this->_simCache != nullptr) {
+            std::cout << "  \u2218 PrunedBaseCache stats -> ";
+            this->_simCache->dumpStats();
+        }
         if(this->_pCache != nullptr) {
             std::cout << "  \u2218 ProductCache stats -> ";
             this->_pCache->dumpStats();
@@ -544,28 +727,41 @@ namespace Workshops {
     }
 
     Symbol* SymbolWorkshop::CreateTrimmedSymbol(Symbol* src, Gaston::VarList* varList) {
-        // Fixme: Refactor
-        size_t varNum = varMap.TrackLength();
         // There are no symbols to trim, so we avoid the useless copy
         if(varList->size() == 0) {
             return src;
-        // Check if maybe everything was trimmed?
-        } else {
-            bool allTrimmed = true;
-            auto it = varList->begin();
-            auto end = varList->end();
-            // For each var, if it is not present in the free vars, we project it away
-            for(; it != end;) {
-                if(!src->IsDontCareAt(*(it++))) {
-                    allTrimmed = false;
-                    break;
-                }
-            }
+        }
+#       if (OPT_SYMBOL_TABLES == true)
+        Symbol* trimmed = this->_trimmedTable.Lookup(src);
+        if(trimmed == nullptr) {
+            trimmed = this->_TrimSymbol(src, varList);
+            this->_trimmedTable.Store(src, trimmed);
+        }
+        return trimmed;
+#       else
+        return this->_TrimSymbol(src, varList);
+#       endif
+    }
 
-            if(allTrimmed) {
-                return src;
+    /**
+     * Projects the variables of @p varList away from the @p src
+     *
+     * @param[in] src:  trimmed symbol
+     * @param[in] varList:  variables not occuring in the automaton
+     * @return  trimmed symbol, or @p src if there is nothing to trim
+     */
+    Symbol* SymbolWorkshop::_TrimSymbol(Symbol* src, Gaston::VarList* varList) {
+        // Check if maybe everything was trimmed?
+        bool allTrimmed = true;
+        for(auto it = varList->begin(); it != varList->end(); ++it) {
+            if(!src->IsDontCareAt(*it)) {
+                allTrimmed = false;
+                break;
             }
         }
+        if(allTrimmed) {
+            return src;
+        }
 
         auto symbolKey = src;
         Symbol* sPtr;
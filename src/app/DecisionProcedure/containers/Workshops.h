@@ -39,6 +39,8 @@
 
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <functional>
 #include <tuple>
 #include <boost/functional/hash.hpp>
@@ -206,6 +208,7 @@ namespace Workshops {
     private:
         // <<< PRIVATE MEMBERS >>>
         BaseCache* _bCache;
+        BaseCache* _simCache;   // Sets pruned by simulation to their representatives
         ProductCache* _ubCache; // Union of Bases Cache
         ProductCache* _pCache;
         TernaryCache* _tpCache;
@@ -232,6 +235,7 @@ namespace Workshops {
         // <<< PRIVATE FUNCTIONS >>>
         template<class A, class B, class C, class D, void (*E)(const A&), void (*F)(B&)>
         inline static BinaryCache<A, B, C, D, E, F>* _cleanCache(BinaryCache<A, B, C, D, E, F>*, bool noMemberDelete = false);
+        Term* _CreateUniqueBaseSet(VATA::Util::OrdVector<size_t> &&);
 
     public:
         static unsigned long monaAutomataStates;
@@ -258,6 +262,9 @@ namespace Workshops {
         Term* CreateList(Term_ptr const&, bool);
         Term* CreateContinuation(SymLink*, SymbolicAutomaton*, Term* const&, Symbol*, bool, bool lazy = false);
         std::string ToSimpleStats();
+        void PurgeDead(std::unordered_set<Term*> const&, std::vector<Term*>&);
+        static void DestroyTerm(Term*);
+        void DestroyFixpoint(TermFixpoint*);
 
         void Dump();
     };
@@ -269,7 +276,11 @@ namespace Workshops {
         RemapCache* _remappedSymbolCache = nullptr;
         std::list<Symbol*> _trimmedSymbols;
         std::list<Symbol*> _remappedSymbols;
+#       if (OPT_SYMBOL_TABLES == true)
+        DirectSymbolCache<Symbol> _trimmedTable;    // < Trimmed symbols of the recently trimmed source symbols
+#       endif
         Symbol* _CreateProjectedSymbol(Symbol*, VarType, ValType);
+        Symbol* _TrimSymbol(Symbol*, Gaston::VarList*);
 
 #       if (OPT_USE_BOOST_POOL_FOR_ALLOC == true)
         static boost::object_pool<Symbol> _pool;
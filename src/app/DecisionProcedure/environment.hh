@@ -72,7 +72,7 @@ enum class FixpointSemanticType {FIXPOINT, PRE};
 enum class UnfoldedIn {SUBSUMPTION, ISECT_NONEMPTY, COMPARISON, NOWHERE};
 enum class SubsumedType {NOT, YES, PARTIALLY};
 enum class ExampleType {SATISFYING, UNSATISFYING};
-enum class WorklistSearchType {BFS, DFS, UNGROUND_ROOT};
+enum class WorklistSearchType {BFS, DFS, UNGROUND_ROOT, BEST_FIRST};
 enum class ProductType {INTERSECTION, UNION, IMPLICATION, BIIMPLICATION};
 enum class VerificationResult {VERIFIED, UNKNOWN, INCORRECT};
 
@@ -232,13 +232,6 @@ public:
 	}
 };
 
-class GastonOutOfMemory : public std::exception {
-public:
-	virtual const char* what() const throw() {
-		return "Gaston is Out of Memory. Oaw oaw.";
-	}
-};
-
 /****************
  * DEBUG MACROS *
  ****************/
@@ -330,8 +323,11 @@ public:
 #define MEASURE_ATOMS					true	// < Measure the number of atomic formulae
 #define MEASURE_BASE_SIZE				true	// < Measure the maximal and average size of the bases
 #define MEASURE_STATE_SPACE 			true	// < Measures how many instances of terms were created
+#define MEASURE_MEMORY					true	// < Accounts live and peak bytes of terms, caches, symbols, dfas and ast nodes
 #define MEASURE_CACHE_HITS 				true	// < Prints the statistics for each cache on each node
+#define MEASURE_LIVE_CACHE_HITS			false   // < Aggregates the hits of the caches by category for the live statistics
 #define MEASURE_CACHE_BUCKETS			false   // < Prints the statistics for cache buckets
+#define MEASURE_MONA_TABLE_BUCKETS		false   // < Prints the statistics for buckets of MONA DAG and symbol table
 #define MEASURE_CONTINUATION_CREATION	true	// < Measures how many continuations are created
 #define MEASURE_CONTINUATION_EVALUATION	true	// < Measures how many continuations are actually unfolded
 #define MEASURE_RESULT_HITS				true    // < Measure how many times the result hits in cache
@@ -403,7 +399,10 @@ public:
 #define OPT_EXTRACT_MORE_AUTOMATA			false   // < Calls detagger to heuristically convert some subformulae to automata
 #define OPT_UNIQUE_TRIMMED_SYMBOLS			true    // < Will guarantee that there will not be a collisions between symbols after trimming
 #define OPT_UNIQUE_REMAPPED_SYMBOLS			true	// < Will guarantee that there will not be a collisions between symbols after remapping
+#define OPT_SYMBOL_TABLES					true    // < Trimmed and remapped symbols are looked up in direct-mapped tables by the id of the source symbol
+#define OPT_SYMBOL_TABLE_SIZE				256     // < Number of slots of each of the symbol tables (power of two)
 #define OPT_FIXPOINT_BFS_SEARCH	        	false   // (-) < Will add new things to the back of the worklist in fixpoint
+#define OPT_FIXPOINT_BEST_FIRST_SEARCH		false   // < Will keep the worklist of fixpoints ordered by the score of items (lower first), as --best-first does
 #define OPT_USE_DENSE_HASHMAP				false	// (-) < Will use the google::dense_hash_map as cache
 #define OPT_NO_SATURATION_FOR_M2L			true    // < Will not saturate the final states for M2L(str) logic
 #define OPT_SHORTTEST_FIXPOINT_SUB			false   // (-) < Will check the generators instead of of whole fixpoints
@@ -427,10 +426,47 @@ public:
 #define OPT_PARTIAL_PRUNE_FIXPOINTS         false   // < Will use the partial subsumption on fixpoint members
 #define OPT_USE_BASE_PROJECTION_AUTOMATA    true    // < Will treat base projections differently (as bases not fixpoints)
 #define OPT_CACHE_SUBPATHS_IN_WRAPPER       true    // < Will cache the nodes and subpaths during the pre computing in mona wrapper
+#define OPT_USE_EXPLICIT_PRE_TABLES         true    // < Will precompute explicit pre tables for small base automata
+#define OPT_EXPLICIT_PRE_TABLE_BUDGET       65536   // < Maximal size (in bytes) of one explicit pre table
+#define OPT_USE_MTBDD_BASE_BACKEND          false   // < Will compute pre of base automata on reversed transition MTBDDs instead of mona wrapper
+#define OPT_MTBDD_BACKEND_MIN_STATES        0       // < Minimal number of states of base automaton to use the MTBDD backend
+#define OPT_MTBDD_PRE_CACHE_SIZE            65536   // < Number of cached nodes and unions of one MTBDD backend, before its caches are purged
+#define OPT_USE_BASE_SIMULATION             true    // < Will use backward simulation over states of small base automata in subsumption
+#define OPT_GOVERNOR_POLL_PERIOD            1024    // < Number of safe points between checks of wall time and memory by resource governor
+#define OPT_TRACE_BUFFER_SIZE               (1 << 20) // < Number of events kept in the ring buffer of tracer
+#define OPT_TRACE_SAMPLE_PERIOD             256     // < Number of fixpoint iterations between samples of cache sizes in trace
+#define OPT_MEMORY_SNAPSHOT_PERIOD          100     // < Minimal period (in ms) of the snapshots of memory accounting
+#define OPT_LIVE_STATS_TOP_FIXPOINTS        5       // < Number of the biggest active fixpoints printed in live statistics
+#if defined(GASTON_TEST_RECLAIM)
+// Test build (gaston_reclaim) reclaims the terms at every iteration of the root fixpoint
+#define OPT_RECLAIM_DEAD_TERMS              true
+#define OPT_RECLAIM_MIN_BYTES               0
+#define OPT_RECLAIM_GROWTH_FACTOR           0
+#else
+#define OPT_RECLAIM_DEAD_TERMS              false   // < [EXPERIMENTAL] Reclaims unreachable terms during the root fixpoint iteration
+#define OPT_RECLAIM_MIN_BYTES               (64 << 20) // < Minimal accounted memory (in bytes) before the first reclamation of terms
+#define OPT_RECLAIM_GROWTH_FACTOR           2       // < Reclamation runs when accounted memory grows by this factor since the last one
+#endif
 #define OPT_DEFIRSTORDER_UNGROUND           false   // < Will call Defirstorderer on Unground formula restriction (Fixme: maybe incorrect)
+#define OPT_SHARE_MONA_CODE                 false   // < [EXPERIMENTAL] Keeps the MONA code table with DFAs of its nodes between constructions of base automata
+#define OPT_SHARE_MONA_CODE_BYTES           (16 << 20) // < Maximal size (in bytes) of the DFAs kept by the shared MONA code table
+#define OPT_SHARE_PREDICATE_AUTOMATA        false   // < [EXPERIMENTAL] Predicates are preprocessed once and call sites are bound to their automata through remapping
+#define OPT_PARALLEL_MONA_TRANSLATION       false   // < [EXPERIMENTAL] Big conjuncts (disjuncts) of MONA code are translated to DFAs in forked workers
+#define OPT_MONA_TRANSLATION_WORKERS        4       // < Maximal number of workers translating MONA code at once
+#define OPT_MONA_WORKER_MIN_DEPTH           6       // < Minimal depth of MONA code that is translated by the worker
+#define OPT_MONA_WORKER_POLL_INTERVAL       1000    // < Interval of polling the workers (in us) when other child has exited
+#define OPT_NARY_PROBE_MIN_ARITY            4       // < Minimal arity of nary intersection, whose operands are probed with --nary-workers
+#define OPT_NARY_PROBE_MAX_WORKERS          64      // < Maximal value of the --nary-workers option
+#define OPT_CLUSTER_CONJUNCTS               false   // < [EXPERIMENTAL] Partitions conjuncts constructed by MONA into clusters with predicted products under the budget
+#define OPT_CLUSTER_STATE_BUDGET            512     // < Maximal predicted number of states of the MONA product of one cluster
+#define OPT_ADAPTIVE_MAX_FIXPOINTS          3       // < With -cfauto, subformulae with more fixpoints are always constructed symbolically
+#define OPT_ADAPTIVE_FIXPOINT_WEIGHT        4       // < With -cfauto, predicted cost of one symbolic fixpoint relative to the MONA projection
+#define OPT_SCHEDULE_QUANTIFIERS            false   // < [EXPERIMENTAL] Anti-prenexing regroups the chains of operands to project each variable over the cheapest group
+#define OPT_ORDER_TRACKS                    false   // < [EXPERIMENTAL] Tracks (and BDD variables of MONA) are ordered to minimize the bandwidth of interacting variables
 
 /* >>> Static Assertions <<< *
  *****************************/
 static_assert(!(MONA_FAIR_MODE == true && MIGHTY_GASTON == true), "Gaston cannot be might and fair at the same time!");
 static_assert(sizeof(size_t) == 8, "Shuffling of hashes require 64bit architecture");
+static_assert(!(OPT_SHARE_PREDICATE_AUTOMATA == true && OPT_EARLY_EVALUATION == true), "Shared predicate automata cannot be evaluated early");
 #endif
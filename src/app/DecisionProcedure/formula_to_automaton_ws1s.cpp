@@ -30,6 +30,7 @@
 
 #include "visitors/transformers/Derestricter.h"
 #include "visitors/transformers/ShuffleVisitor.h"
+#include "utils/ParallelTranslation.h"
 
 #if (OPT_SMARTER_MONA_CONVERSION == true)
 #include "mtbdd/mtbddconverter2.hh"
@@ -771,7 +772,16 @@ void toMonaAutomaton(ASTForm* form, DFA*& dfa, bool minimize) {
 #   endif
 
 	// Conversion of formula representation from AST to DAG
+#   if (OPT_SHARE_MONA_CODE == true)
+	// The table survives between the base automata, so the shared subcodes are translated to DFA only once
+	if(codeTable == nullptr) {
+		codeTable = new CodeTable;
+		codeTable->persistent = true;
+		codeTable->retainLimit = OPT_SHARE_MONA_CODE_BYTES;
+	}
+#   else
 	codeTable = new CodeTable;
+#   endif
 	VarCode formulaCode = form->makeCode();
 
 	// Reduce the formula by MONA optimizations
@@ -793,7 +803,14 @@ void toMonaAutomaton(ASTForm* form, DFA*& dfa, bool minimize) {
 	codeTable->init_print_progress();
 
 	// Translation to DFA
+#   if (OPT_PARALLEL_MONA_TRANSLATION == true)
+	dfa = ParallelTranslation::DFATranslate(formulaCode);
+#   else
 	dfa = formulaCode.DFATranslate();
+#   endif
+#   if (MEASURE_MONA_TABLE_BUCKETS == true)
+	codeTable->print_bucket_statistics();
+#   endif
 	formulaCode.remove();
 
 	// Unrestriction of MONA automaton
@@ -812,7 +829,9 @@ void toMonaAutomaton(ASTForm* form, DFA*& dfa, bool minimize) {
     delete varnames;
     delete[] offs;
 #   endif
+#   if (OPT_SHARE_MONA_CODE == false)
 	delete codeTable;
+#   endif
 }
 
 IdentList* initializeVars(ASTForm *form) {
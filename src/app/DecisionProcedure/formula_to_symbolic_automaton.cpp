@@ -6,9 +6,11 @@
 #include "../Frontend/timer.h"
 #include "../Frontend/offsets.h"
 #include "../Frontend/env.h"
+#include "../Frontend/predlib.h"
 #include "containers/SymbolicAutomata.h"
 #include "environment.hh"
 #include "automata.hh"
+#include "utils/Tracer.h"
 #include "visitors/restricters/NegationUnfolder.h"
 #include "visitors/transformers/Derestricter.h"
 #include <memory>
@@ -17,6 +19,7 @@ extern Timer timer_base;
 extern VarToTrackMap varMap;
 extern Offsets offsets;
 extern Options options;
+extern PredicateLib predicateLib;
 
 template<class TemplatedAutomaton>
 SymbolicAutomaton* baseToSymbolicAutomaton(ASTForm* form, bool doComplement) {
@@ -28,8 +31,10 @@ SymbolicAutomaton* baseToSymbolicAutomaton(ASTForm* form, bool doComplement) {
     IdentList free, bound;
     form->freeVars(&free, &bound);
 
+    std::uint64_t traceStart = Tracer::Now();
     toMonaAutomaton(form, dfa, true);
     assert(dfa != nullptr);
+    Tracer::Complete("DFA creation", "mona", traceStart, "states", dfa->ns);
 
     // Fixme: free.empty() should be composed here somehow
     bool hasEmptyTracks = (free.empty() && form->kind != aTrue && form->kind != aFalse) || dfa->ns == 1;
@@ -52,7 +57,7 @@ SymbolicAutomaton* ASTForm::toSymbolicAutomaton(bool doComplement) {
             // If yes, return the automaton (the mapping will be constructed internally)
 #       endif
 #           if (OPT_USE_BASE_PROJECTION_AUTOMATA == true)
-            if(this->tag == 0 || this->fixpoint_number == 0) {
+            if((this->tag == 0 || this->fixpoint_number == 0) && !this->is_cluster_product) {
 #           else
             if(this->tag == 0) {
 #           endif
@@ -75,6 +80,19 @@ SymbolicAutomaton* ASTForm::toSymbolicAutomaton(bool doComplement) {
     return this->sfa;
 }
 
+/**
+ * Binds the call to the automaton of the shared body of the predicate. The body is constructed only once for all of
+ * the call sites, parents of the call remap the real parameters to the formal ones through their links.
+ */
+SymbolicAutomaton* ASTForm_Call::toSymbolicAutomaton(bool doComplement) {
+    if(this->sfa == nullptr) {
+        ASTForm* body = predicateLib.lookup(this->n)->sharedAst;
+        assert(body != nullptr && "Call was kept without preprocessing of the predicate");
+        this->sfa = body->toSymbolicAutomaton(doComplement);
+    }
+    return this->sfa;
+}
+
 SymbolicAutomaton* ASTForm::_toSymbolicAutomatonCore(bool doComplement) {
 #   if (AUT_CONSTRUCT_BY_MONA == true)
     return baseToSymbolicAutomaton<GenericBaseAutomaton>(this, doComplement);
@@ -120,19 +138,26 @@ SymbolicAutomaton* ASTForm_Sub::_toSymbolicAutomatonCore(bool doComplement) {
     return baseToSymbolicAutomaton<SubAutomaton>(this, doComplement);
 }
 
+/**
+ * @return  true if the @p form is product constructed symbolically (and not by MONA)
+ */
+inline bool is_symbolic_product(ASTForm* form) {
+    return form->fixpoint_number > 0 || form->is_cluster_product;
+}
+
 template<class FormClass>
 bool has_consecutive_products(FormClass* form) {
     ASTKind k = form->kind;
-    if(form->f1->kind == k && form->f1->fixpoint_number > 0) {
+    if(form->f1->kind == k && is_symbolic_product(form->f1)) {
         FormClass* f1_form = static_cast<FormClass*>(form->f1);
-        return    (   form->f2->kind == k &&    form->f2->fixpoint_number > 0)
-               || (f1_form->f1->kind == k && f1_form->f1->fixpoint_number > 0)
-               || (f1_form->f2->kind == k && f1_form->f2->fixpoint_number > 0);
+        return    (   form->f2->kind == k && is_symbolic_product(form->f2))
+               || (f1_form->f1->kind == k && is_symbolic_product(f1_form->f1))
+               || (f1_form->f2->kind == k && is_symbolic_product(f1_form->f2));
     } else if(form->f2->kind == k) {
-        assert(form->f1->kind != k || form->f1->fixpoint_number == 0);
+        assert(form->f1->kind != k || !is_symbolic_product(form->f1));
         FormClass* f2_form = static_cast<FormClass*>(form->f2);
-        return    (f2_form->f1->kind == k && f2_form->f1->fixpoint_number > 0)
-               || (f2_form->f2->kind == k && f2_form->f2->fixpoint_number > 0);
+        return    (f2_form->f1->kind == k && is_symbolic_product(f2_form->f1))
+               || (f2_form->f2->kind == k && is_symbolic_product(f2_form->f2));
     } else {
         return false;
     }
@@ -149,7 +174,7 @@ SymbolicAutomaton* product_to_automaton(FormClass* form, bool doComplement) {
         // Create nary representation
         return new NaryProduct(form, doComplement);
 #   if (OPT_USE_TERNARY_AUTOMATA == true)
-    } else if(form->f1->kind == k && form->f1->fixpoint_number > 0) {
+    } else if(form->f1->kind == k && is_symbolic_product(form->f1)) {
         // Create ternary representation
         ASTForm_ff* form_f1 = static_cast<ASTForm_ff*>(form->f1);
         SymbolicAutomaton* lhs_aut;
@@ -159,7 +184,7 @@ SymbolicAutomaton* product_to_automaton(FormClass* form, bool doComplement) {
         SymbolicAutomaton* rhs_aut;
         rhs_aut = form->f2->toSymbolicAutomaton(doComplement);
         return new TernaryProduct(lhs_aut, mhs_aut, rhs_aut, form);
-    } else if(form->f2->kind == k && form->f1->kind != k && form->f2->fixpoint_number > 0) {
+    } else if(form->f2->kind == k && form->f1->kind != k && is_symbolic_product(form->f2)) {
         // Create ternary representation
         ASTForm_ff* form_f2 = static_cast<ASTForm_ff*>(form->f2);
         SymbolicAutomaton* lhs_aut;
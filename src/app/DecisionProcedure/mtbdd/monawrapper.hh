@@ -5,10 +5,12 @@
 #include "../containers/SymbolicCache.hh"
 
 #include <vata/util/ord_vector.hh>
+#include <vata/util/binary_relation.hh>
 
 #include "ondriks_mtbdd.hh"
 #include "../containers/VarToTrackMap.hh"
 #include "../environment.hh"
+#include "../utils/MemoryAccounting.h"
 
 #include <vector>
 #include <unordered_map>
@@ -17,6 +19,7 @@
 #include <assert.h>
 #include <string>
 #include <fstream>
+#include <cstdint>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/pool/object_pool.hpp>
 
@@ -102,8 +105,17 @@ protected:
     CacheType cache_;
     static boost::object_pool<WrappedNode> nodePool_;
 
+    // Explicit pre table: rows indexed by (state, ternary symbol over occurring tracks)
+    std::vector<unsigned> tableTracks_;         // < Tracks that are tested in some bdd of dfa
+    std::vector<uint64_t> preTable_;            // < Rows of predecessor bitsets
+    size_t tableSymbols_ = 0;                   // < Number of ternary symbols, i.e. 3^|tableTracks_|
+    size_t tableWords_ = 0;                     // < Number of 64bit words per row
+    size_t accountedBytes_ = 0;                 // < Footprint of dfa, wrapped nodes and pre table
+
 public:
     static int _wrapperCount;
+    static size_t _tableCount;                  // < Number of wrappers that use the explicit pre table
+    static size_t _tableBytes;                  // < Overall memory used by explicit pre tables
 #   if (MEASURE_AUTOMATA_CYCLES == true)
     static size_t noAllFinalStatesHasCycles;    // < Number of wrapped automata, that satisfy the condition
     static size_t noSomeFinalStatesHasCycles;   // < Number of wrapped automata that satisfy this condition
@@ -140,7 +152,7 @@ private:
         //leafNodes_[state] = new WrappedNode(state, 0xfffffffe);
         LOAD_index(&bddm->node_table[addr], index);
 
-        if(index != BDD_LEAF_INDEX && varMap[index] == 0)
+        if(index != BDD_LEAF_INDEX && varMap.TrackOfOffset(index) == 0)
             return leafNodes_[state];
 
         WrappedNode *result = spawnNode(addr, *leafNodes_[state], 1);
@@ -163,7 +175,7 @@ private:
         }
         else
         {
-            node.var_ = SetVar(varMap[index]);
+            node.var_ = SetVar(varMap.TrackOfOffset(index));
             RecSetPointer(bddm, l, *spawnNode(l, node, 0));
             RecSetPointer(bddm, r, *spawnNode(r, node, 1));
         }
@@ -383,6 +395,105 @@ private:
         return CreateResultSet(nodes);
     }
 
+    void CollectTracks(const bdd_manager *bddm, unsigned p, std::vector<bool> &occurs, std::unordered_set<unsigned> &visited)
+    {
+        unsigned l, r, index;
+
+        if(!visited.insert(p).second)
+            return;
+
+        LOAD_lri(&bddm->node_table[p], l, r, index);
+        if (index != BDD_LEAF_INDEX)
+        {
+            occurs[varMap.TrackOfOffset(index)] = true;
+            CollectTracks(bddm, l, occurs, visited);
+            CollectTracks(bddm, r, occurs, visited);
+        }
+    }
+
+    /**
+     * Walks the paths of the bdd rooted in @p p and for each reached leaf marks @p source as
+     * predecessor of the leaf under every ternary symbol that is compatible with the path.
+     *
+     * @param[in] path:     partial assignment of occurring tracks on the path (0, 1 or 2 for untested)
+     */
+    void FillPreTable(const bdd_manager *bddm, unsigned p, size_t source, std::vector<unsigned char> &path, std::vector<int> &trackPos)
+    {
+        unsigned l, r, index;
+
+        LOAD_lri(&bddm->node_table[p], l, r, index);
+        if (index == BDD_LEAF_INDEX)
+        {
+            MarkCompatibleSymbols(l, source, path, 0, 0, 1);
+        }
+        else
+        {
+            int pos = trackPos[varMap.TrackOfOffset(index)];
+            unsigned char previous = path[pos];
+            path[pos] = 0;
+            FillPreTable(bddm, l, source, path, trackPos);
+            path[pos] = 1;
+            FillPreTable(bddm, r, source, path, trackPos);
+            path[pos] = previous;
+        }
+    }
+
+    void MarkCompatibleSymbols(size_t target, size_t source, std::vector<unsigned char> &path, size_t pos, size_t symIdx, size_t weight)
+    {
+        if(pos == path.size())
+        {
+            preTable_[(target*tableSymbols_ + symIdx)*tableWords_ + (source >> 6)] |= (uint64_t(1) << (source & 63));
+            return;
+        }
+
+        // Don't care in symbol is compatible with everything
+        MarkCompatibleSymbols(target, source, path, pos + 1, symIdx + 2*weight, weight*3);
+        if(path[pos] != 1)
+            MarkCompatibleSymbols(target, source, path, pos + 1, symIdx, weight*3);
+        if(path[pos] != 0)
+            MarkCompatibleSymbols(target, source, path, pos + 1, symIdx + weight, weight*3);
+    }
+
+    bool IsRowSimulated(const uint64_t *lhs, const uint64_t *rhs, VATA::Util::BinaryRelation &sim)
+    {
+        for(size_t w = 0; w < tableWords_; ++w)
+        {
+            for(uint64_t word = lhs[w]; word != 0; word &= word - 1)
+            {
+                size_t p = (w << 6) + __builtin_ctzll(word);
+                bool simulated = false;
+                for(size_t v = 0; v < tableWords_ && !simulated; ++v)
+                {
+                    for(uint64_t qword = rhs[v]; qword != 0; qword &= qword - 1)
+                    {
+                        if(sim.get(p, (v << 6) + __builtin_ctzll(qword)))
+                        {
+                            simulated = true;
+                            break;
+                        }
+                    }
+                }
+                if(!simulated)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    inline size_t TableSymbolIndex(const Gaston::BitMask &symbol)
+    {
+        size_t symIdx = 0, weight = 1;
+        for(auto track : tableTracks_)
+        {
+            if(symbol[(track << 1) + 1])
+                symIdx += 2*weight;
+            else if(symbol[track << 1])
+                symIdx += weight;
+            weight *= 3;
+        }
+        return symIdx;
+    }
+
 public:
     MonaWrapper(DFA *dfa, bool emptyTracks, bool is_restriction, unsigned numVars = 0)
             : dfa_(dfa), numVars_(numVars), initialState_(emptyTracks ? 0 : 1), isRestriction_(is_restriction)
@@ -417,10 +528,13 @@ public:
             RecSetPointer(dfa->bddm, dfa->q[i], *spawnNode(dfa->bddm, dfa->q[i], i));
 
         ++MonaWrapper<Data>::_wrapperCount;
+        cache_.SetCategory(MemoryCategory::WRAPPER_CACHE);
+        UpdateAccounting();
     }
 
     ~MonaWrapper()
     {
+        MemoryAccounting::Release(MemoryCategory::MONA_DFA, accountedBytes_);
         delete[] this->masks_;
         delete[] this->symbolMasks_;
         dfaFree(this->dfa_);
@@ -499,10 +613,10 @@ public:
         }
         else
         {
-            transition[varMap[index]] = '0';
+            transition[varMap.TrackOfOffset(index)] = '0';
             GetAllPathFromMona(os, bddm, l, transition, root, varNum);
 
-            transition[varMap[index]] = '1';
+            transition[varMap.TrackOfOffset(index)] = '1';
             GetAllPathFromMona(os, bddm, r, transition, root, varNum);
         }
     }
@@ -571,6 +685,161 @@ public:
         return RecPre(nodes);
     }
 
+    /**
+     * Precomputes the dense table of predecessors for each pair of state and ternary symbol over
+     * tracks that occur in the automaton, if the table fits into @p budget bytes.
+     *
+     * @param[in] budget:   maximal size of the table in bytes
+     * @return: true if the table was built
+     */
+    bool BuildPreTable(size_t budget)
+    {
+        assert(dfa_ != nullptr);
+        std::vector<bool> occurs(numVars_, false);
+        std::unordered_set<unsigned> visited;
+        for(size_t i = this->initialState_; i < dfa_->ns; ++i)
+            CollectTracks(dfa_->bddm, dfa_->q[i], occurs, visited);
+
+        std::vector<int> trackPos(numVars_, -1);
+        std::vector<unsigned> tracks;
+        for(unsigned i = 0; i < numVars_; ++i)
+        {
+            if(occurs[i])
+            {
+                trackPos[i] = tracks.size();
+                tracks.push_back(i);
+            }
+        }
+
+        size_t words = (dfa_->ns + 63) >> 6;
+        size_t symbols = 1;
+        for(size_t i = 0; i < tracks.size(); ++i)
+        {
+            symbols *= 3;
+            if(symbols*words*dfa_->ns*sizeof(uint64_t) > budget)
+                return false;
+        }
+        if(symbols*words*dfa_->ns*sizeof(uint64_t) > budget)
+            return false;
+
+        tableTracks_ = std::move(tracks);
+        tableSymbols_ = symbols;
+        tableWords_ = words;
+        preTable_.assign(dfa_->ns*symbols*words, 0);
+
+        std::vector<unsigned char> path(tableTracks_.size(), 2);
+        for(size_t i = this->initialState_; i < dfa_->ns; ++i)
+            FillPreTable(dfa_->bddm, dfa_->q[i], i, path, trackPos);
+
+        ++MonaWrapper<Data>::_tableCount;
+        MonaWrapper<Data>::_tableBytes += preTable_.size()*sizeof(uint64_t);
+        UpdateAccounting();
+        return true;
+    }
+
+    /**
+     * Updates the accounted footprint of the wrapped dfa (states and bdd table), its wrapped
+     * nodes and the explicit pre table
+     */
+    void UpdateAccounting()
+    {
+        size_t bytes = dfa_->ns*(sizeof(bdd_handle) + sizeof(int))
+                       + bdd_size(dfa_->bddm)*sizeof(bdd_record)
+                       + (leafNodes_.size() + internalNodes_.size())*sizeof(WrappedNode)
+                       + preTable_.size()*sizeof(uint64_t);
+        MemoryAccounting::Resize(MemoryCategory::MONA_DFA, accountedBytes_, bytes);
+    }
+
+    inline bool HasPreTable() const
+    {
+        return tableWords_ != 0;
+    }
+
+    /**
+     * Computes the pre of @p states through @p symbol as union of rows of explicit pre table
+     */
+    VectorType TablePre(const VATA::Util::OrdVector<size_t> &states, const Gaston::BitMask &symbol)
+    {
+        assert(HasPreTable());
+        size_t symIdx = TableSymbolIndex(symbol);
+
+        std::vector<uint64_t> acc(tableWords_, 0);
+        for(auto state: states)
+        {
+            assert(state < dfa_->ns);
+            const uint64_t *row = &preTable_[(state*tableSymbols_ + symIdx)*tableWords_];
+            for(size_t w = 0; w < tableWords_; ++w)
+                acc[w] |= row[w];
+        }
+
+        std::vector<Data> res;
+        for(size_t w = 0; w < tableWords_; ++w)
+        {
+            for(uint64_t word = acc[w]; word != 0; word &= word - 1)
+                res.push_back((w << 6) + __builtin_ctzll(word));
+        }
+        return VectorType(res);
+    }
+
+    /**
+     * Computes the backward simulation over states from the explicit pre table, i.e. the greatest
+     * relation such that if p is simulated by q, then q is initial if p is initial and each predecessor
+     * of p under some letter is simulated by some predecessor of q under the same letter.
+     *
+     * @param[out] sim:     computed simulation
+     * @return: true if simulation relates some distinct states
+     */
+    bool ComputeBackwardSimulation(VATA::Util::BinaryRelation &sim)
+    {
+        assert(HasPreTable());
+        size_t states = dfa_->ns;
+        sim.resize(states, true);
+        sim.reset(true);
+        for(size_t q = 0; q < states; ++q)
+            if(q != this->initialState_)
+                sim.set(this->initialState_, q, false);
+
+        // Indices of the table symbols, that contain no don't care
+        std::vector<size_t> letters(1, 0);
+        size_t weight = 1;
+        for(size_t i = 0; i < tableTracks_.size(); ++i, weight *= 3)
+        {
+            size_t letterNum = letters.size();
+            for(size_t l = 0; l < letterNum; ++l)
+                letters.push_back(letters[l] + weight);
+        }
+
+        bool changed = true;
+        while(changed)
+        {
+            changed = false;
+            for(size_t p = 0; p < states; ++p)
+            {
+                for(size_t q = 0; q < states; ++q)
+                {
+                    if(p == q || !sim.get(p, q))
+                        continue;
+                    for(auto letter: letters)
+                    {
+                        if(!IsRowSimulated(&preTable_[(p*tableSymbols_ + letter)*tableWords_],
+                                           &preTable_[(q*tableSymbols_ + letter)*tableWords_], sim))
+                        {
+                            sim.set(p, q, false);
+                            changed = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        for(size_t p = 0; p < states; ++p)
+            for(size_t q = 0; q < states; ++q)
+                if(p != q && sim.get(p, q))
+                    return true;
+        return false;
+    }
+
     void ProcessDFA(DFA *dfa)
     {
         dfa_ = dfa;
@@ -636,6 +905,10 @@ public:
 
 template<class Data>
 int MonaWrapper<Data>::_wrapperCount = 0;
+template<class Data>
+size_t MonaWrapper<Data>::_tableCount = 0;
+template<class Data>
+size_t MonaWrapper<Data>::_tableBytes = 0;
 #   if (MEASURE_AUTOMATA_CYCLES == true)
 template<class Data>
 size_t MonaWrapper<Data>::noAllFinalStatesHasCycles = 0;    // < Number of wrapped automata, that satisfy the condition
@@ -0,0 +1,227 @@
+#ifndef MTBDDWRAPPER_H
+#define MTBDDWRAPPER_H
+
+#include "../../Frontend/ast.h"
+#include "../containers/SymbolicCache.hh"
+
+#include <vata/util/ord_vector.hh>
+#include <vata/sym_var_asgn.hh>
+
+#include "ondriks_mtbdd.hh"
+#include "apply2func.hh"
+#include "../containers/VarToTrackMap.hh"
+#include "../environment.hh"
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <assert.h>
+#include <boost/dynamic_bitset.hpp>
+
+extern VarToTrackMap varMap;
+
+/**
+ * Alternative backend of base automata, that converts the mona DFA to reversed transition
+ * relation represented by MTBDDs, i.e. for each state q there is an MTBDD mapping the symbols
+ * over tracks to sets of predecessors of q.
+ */
+template<class Data>
+class MTBDDWrapper
+{
+private:
+    using VectorType    = VATA::Util::OrdVector<Data>;
+    using MTBDD         = VATA::MTBDDPkg::OndriksMTBDD<VectorType>;
+    using NodePtrType   = VATA::MTBDDPkg::MTBDDNodePtr<VectorType>;
+    using KeyType       = std::pair<NodePtrType, Gaston::BitMask>;
+
+    struct HashType
+    {
+        size_t operator()(KeyType const& key) const
+        {
+            size_t seed = boost::hash<NodePtrType>()(key.first);
+            boost::hash_combine(seed, boost::hash_value(key.second));
+            return seed;
+        }
+    };
+
+    struct SetHashType
+    {
+        size_t operator()(VectorType const& set) const
+        {
+            return boost::hash_range(set.begin(), set.end());
+        }
+    };
+
+    using CacheType     = std::unordered_map<KeyType, VectorType, HashType>;
+    using SetCacheType  = std::unordered_map<VectorType, MTBDD, SetHashType>;
+
+    class UnionApply : public VATA::MTBDDPkg::Apply2Functor<UnionApply, VectorType, VectorType, VectorType>
+    {
+    public:
+        VectorType ApplyOperation(const VectorType& lhs, const VectorType& rhs)
+        {
+            return lhs.Union(rhs);
+        }
+    };
+
+protected:
+    std::vector<MTBDD> pre_;                // < Reversed transition MTBDD for each state
+    std::vector<Gaston::BitMask> masks_;    // < Masks of symbol restricted to tracks under given variable
+    unsigned numVars_;
+    CacheType cache_;                       // < Node-level cache of (node, subsymbol) -> predecessors
+    SetCacheType unions_;                   // < Reversed transition MTBDDs of the base sets
+    UnionApply unionFunc_;
+
+public:
+    static size_t _wrapperCount;
+    static size_t cacheHits;
+    static size_t cacheMisses;
+    static size_t cachePurges;
+
+private:
+    void RecCollectPaths(const bdd_manager *bddm, unsigned p, size_t source, VATA::SymbolicVarAsgn &asgn, UnionApply &unionFunc)
+    {
+        unsigned l, r, index;
+
+        LOAD_lri(&bddm->node_table[p], l, r, index);
+        if (index == BDD_LEAF_INDEX)
+        {
+            MTBDD path(asgn, VectorType(source), VectorType());
+            pre_[l] = unionFunc(pre_[l], path);
+        }
+        else
+        {
+            unsigned track = varMap.TrackOfOffset(index);
+            asgn.SetIthVariableValue(track, VATA::SymbolicVarAsgn::ZERO);
+            RecCollectPaths(bddm, l, source, asgn, unionFunc);
+            asgn.SetIthVariableValue(track, VATA::SymbolicVarAsgn::ONE);
+            RecCollectPaths(bddm, r, source, asgn, unionFunc);
+            asgn.SetIthVariableValue(track, VATA::SymbolicVarAsgn::DONT_CARE);
+        }
+    }
+
+    /**
+     * Descends the MTBDD according to the @p symbol, where don't care tracks are descended
+     * through both branches and the reached leaves are unioned.
+     */
+    VectorType RecPre(const NodePtrType &node, const Gaston::BitMask &symbol)
+    {
+        if(VATA::MTBDDPkg::IsLeaf(node))
+            return VATA::MTBDDPkg::GetDataFromLeaf(node);
+
+        size_t var = VATA::MTBDDPkg::GetVarFromInternal(node);
+        Gaston::BitMask subsymbol = symbol;
+        subsymbol &= masks_[var];
+        KeyType key = std::make_pair(node, subsymbol);
+
+        auto it = cache_.find(key);
+        if(it != cache_.end())
+        {
+            ++MTBDDWrapper<Data>::cacheHits;
+            return it->second;
+        }
+        ++MTBDDWrapper<Data>::cacheMisses;
+
+        VectorType res;
+        if(symbol[(var << 1) + 1])
+        {
+            res = RecPre(VATA::MTBDDPkg::GetLowFromInternal(node), symbol).Union(
+                  RecPre(VATA::MTBDDPkg::GetHighFromInternal(node), symbol));
+        }
+        else if(symbol[var << 1])
+        {
+            res = RecPre(VATA::MTBDDPkg::GetHighFromInternal(node), symbol);
+        }
+        else
+        {
+            res = RecPre(VATA::MTBDDPkg::GetLowFromInternal(node), symbol);
+        }
+
+        cache_.insert(std::make_pair(key, res));
+        return res;
+    }
+
+    /**
+     * Purges the caches once they reach OPT_MTBDD_PRE_CACHE_SIZE entries. Both caches are purged
+     * together, as the node-level cache refers to the nodes kept alive by the unions.
+     */
+    void PurgeCaches()
+    {
+        if(cache_.size() + unions_.size() >= OPT_MTBDD_PRE_CACHE_SIZE)
+        {
+            cache_.clear();
+            unions_.clear();
+            ++MTBDDWrapper<Data>::cachePurges;
+        }
+    }
+
+    /**
+     * Returns the reversed transition MTBDD of the whole set @p states, i.e. the union of the
+     * MTBDDs of its states computed by the apply.
+     */
+    const MTBDD& SetPre(const VATA::Util::OrdVector<size_t> &states)
+    {
+        auto it = unions_.find(states);
+        if(it != unions_.end())
+            return it->second;
+
+        auto state = states.begin();
+        assert(*state < pre_.size());
+        MTBDD res = pre_[*state];
+        for(++state; state != states.end(); ++state)
+        {
+            assert(*state < pre_.size());
+            res = unionFunc_(res, pre_[*state]);
+        }
+        return unions_.insert(std::make_pair(states, res)).first->second;
+    }
+
+public:
+    MTBDDWrapper(DFA *dfa, size_t initialState, unsigned numVars) : numVars_(numVars)
+    {
+        pre_.resize(dfa->ns, MTBDD(VectorType()));
+
+        Gaston::BitMask mask(numVars_ << 1);
+        masks_.resize(numVars_, mask);
+        for(unsigned i = 0; i < numVars_; ++i) {
+            for(unsigned j = 0; j <= (i << 1) + 1; ++j) {
+                masks_[i][j] = true;
+            }
+        }
+
+        VATA::SymbolicVarAsgn asgn(numVars_);
+        for(size_t i = initialState; i < dfa->ns; ++i)
+            RecCollectPaths(dfa->bddm, dfa->q[i], i, asgn, unionFunc_);
+
+        ++MTBDDWrapper<Data>::_wrapperCount;
+    }
+
+    VectorType Pre(size_t state, const Gaston::BitMask &symbol)
+    {
+        assert(state < pre_.size());
+        PurgeCaches();
+        return RecPre(pre_[state].getRoot(), symbol);
+    }
+
+    VectorType Pre(const VATA::Util::OrdVector<size_t> &states, const Gaston::BitMask &symbol)
+    {
+        if(states.size() == 0)
+            return VectorType();
+        else if(states.size() == 1)
+            return Pre(*states.begin(), symbol);
+
+        PurgeCaches();
+        return RecPre(SetPre(states).getRoot(), symbol);
+    }
+};
+
+template<class Data>
+size_t MTBDDWrapper<Data>::_wrapperCount = 0;
+template<class Data>
+size_t MTBDDWrapper<Data>::cacheHits = 0;
+template<class Data>
+size_t MTBDDWrapper<Data>::cacheMisses = 0;
+template<class Data>
+size_t MTBDDWrapper<Data>::cachePurges = 0;
+
+#endif // MTBDDWRAPPER_H
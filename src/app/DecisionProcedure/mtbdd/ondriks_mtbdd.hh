@@ -30,6 +30,9 @@
 // Boost library headers
 #include <boost/functional/hash.hpp>
 
+template <class>
+class MTBDDWrapper;
+
 namespace VATA
 {
 	namespace MTBDDPkg
@@ -94,6 +97,9 @@ class VATA::MTBDDPkg::OndriksMTBDD
     template <class>
     friend class MTBDDConverter2;
 
+    template <class>
+    friend class ::MTBDDWrapper;
+
 public:   // public data types
 
 	typedef Data DataType;
@@ -0,0 +1,738 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Precompiled formula bundles
+ *****************************************************************************/
+
+#include "FormulaBundle.h"
+#include "../containers/VarToTrackMap.hh"
+#include "../../Frontend/env.h"
+#include "../../Frontend/symboltable.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern Options options;
+extern SymbolTable symbolTable;
+extern VarToTrackMap varMap;
+
+static const char BundleMagic[8] = {'G', 'S', 'T', 'N', 'B', 'N', 'D', 'L'};
+static const std::uint32_t BundleVersion = 2;
+static const std::uint32_t NullString = 0xFFFFFFFF;
+
+/**
+ * @return  true if the identifier of type @p type is variable with restriction and universes
+ */
+static bool isVariable(MonaTypeTag type) {
+    switch(type) {
+        case Varname0: case Varname1: case Varname2: case VarnameTree:
+        case Parname0: case Parname1: case Parname2: case ParnameU:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Checks whether the file at @p path is the formula bundle
+ *
+ * @param[in] path:     path to the file
+ * @return  true if the file starts with the bundle magic
+ */
+bool FormulaBundle::IsBundle(const char* path) {
+    char magic[sizeof(BundleMagic)];
+    std::ifstream in(path, std::ios::binary);
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, BundleMagic, sizeof(magic)) == 0;
+}
+
+/**
+ * Writes the preprocessed formula of @p monaAST, the @p rootRestriction, the symbol table and the tracks of the
+ * variables into the bundle at @p path.
+ *
+ * @param[in] path:             path of the written bundle
+ * @param[in] monaAST:          preprocessed and tagged formula
+ * @param[in] rootRestriction:  restriction of the free variables of unground formula (or nullptr)
+ * @param[in] isGround:         whether the formula is ground
+ * @return  true if the bundle was written
+ */
+bool FormulaBundle::Compile(const char* path, MonaAST* monaAST, ASTForm* rootRestriction, bool isGround) {
+    FormulaBundle bundle;
+    try {
+        if(options.mode == TREE) {
+            throw BundleException("formulae in tree mode are not supported");
+        }
+        bundle._buffer.append(BundleMagic, sizeof(BundleMagic));
+        bundle._Write<std::uint32_t>(BundleVersion);
+        bundle._Write<std::uint8_t>(options.m2l);
+        bundle._Write<std::uint8_t>(isGround);
+        bundle._Write<std::int32_t>(monaAST->lastPosVar);
+        bundle._Write<std::int32_t>(monaAST->allPosVar);
+        bundle._WriteSymbolTable();
+        bundle._WriteTracks();
+        bundle._WriteNode(rootRestriction);
+        bundle._WriteNode(monaAST->formula);
+    } catch (const BundleException& e) {
+        std::cerr << "[!] Formula cannot be compiled into bundle: " << e.what() << "\n";
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(bundle._buffer.data(), bundle._buffer.size());
+    if(!out) {
+        std::cerr << "[!] Cannot write bundle '" << path << "'\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Maps the bundle at @p path into the memory and rebuilds the formula, the symbol table and the tracks of the
+ * variables from it. The symbol table has to be empty.
+ *
+ * @param[in] path:              path to the bundle
+ * @param[out] rootRestriction:  restriction of the free variables of unground formula (or nullptr)
+ * @param[out] isGround:         whether the formula is ground
+ * @return  loaded formula or nullptr if the bundle is malformed
+ */
+MonaAST* FormulaBundle::Load(const char* path, ASTForm*& rootRestriction, bool& isGround) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if(fd == -1 || fstat(fd, &st) == -1 || static_cast<size_t>(st.st_size) < sizeof(BundleMagic)) {
+        std::cerr << "[!] Cannot read bundle '" << path << "'\n";
+        if(fd != -1) {
+            close(fd);
+        }
+        return nullptr;
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED) {
+        std::cerr << "[!] Cannot map bundle '" << path << "'\n";
+        return nullptr;
+    }
+
+    FormulaBundle bundle;
+    bundle._cursor = static_cast<const char*>(data);
+    bundle._end = bundle._cursor + st.st_size;
+    MonaAST* monaAST = nullptr;
+    try {
+        if(std::memcmp(bundle._cursor, BundleMagic, sizeof(BundleMagic)) != 0) {
+            throw BundleException("not a formula bundle");
+        }
+        bundle._cursor += sizeof(BundleMagic);
+        if(bundle._Read<std::uint32_t>() != BundleVersion) {
+            throw BundleException("bundle was compiled by different version");
+        }
+        if(symbolTable.noIdents != 0) {
+            throw BundleException("symbol table is not empty");
+        }
+        options.m2l = bundle._Read<std::uint8_t>();
+        options.mode = LINEAR;
+        isGround = bundle._Read<std::uint8_t>();
+        Ident lastPos = bundle._Read<std::int32_t>();
+        Ident allPos = bundle._Read<std::int32_t>();
+        bundle._ReadSymbolTable();
+        if(lastPos < -1 || allPos < -1 || lastPos >= static_cast<Ident>(symbolTable.noIdents) ||
+           allPos >= static_cast<Ident>(symbolTable.noIdents)) {
+            throw BundleException("invalid identifier");
+        }
+        bundle._ReadTracks();
+        rootRestriction = bundle._ReadForm(true);
+        ASTForm* formula = bundle._ReadForm();
+        if(bundle._cursor != bundle._end) {
+            throw BundleException("malformed formula");
+        }
+
+        monaAST = new MonaAST(formula, nullptr);
+        monaAST->lastPosVar = lastPos;
+        monaAST->allPosVar = allPos;
+    } catch (const BundleException& e) {
+        std::cerr << "[!] Cannot load bundle '" << path << "': " << e.what() << "\n";
+    }
+    munmap(data, st.st_size);
+    return monaAST;
+}
+
+template<class Value>
+void FormulaBundle::_Write(Value value) {
+    this->_buffer.append(reinterpret_cast<const char*>(&value), sizeof(Value));
+}
+
+void FormulaBundle::_WriteString(const char* str) {
+    if(str == nullptr) {
+        this->_Write<std::uint32_t>(NullString);
+    } else {
+        std::uint32_t length = std::strlen(str);
+        this->_Write<std::uint32_t>(length);
+        this->_buffer.append(str, length);
+    }
+}
+
+void FormulaBundle::_WriteIdents(IdentList* idents) {
+    if(idents == nullptr) {
+        this->_Write<std::uint32_t>(NullString);
+    } else {
+        this->_Write<std::uint32_t>(idents->size());
+        for(auto it = idents->begin(); it != idents->end(); ++it) {
+            this->_Write<std::int32_t>(*it);
+        }
+    }
+}
+
+/**
+ * Writes the @p node and its subnodes in preorder. Nodes of tree logics, types and nodes that are removed by the
+ * preprocessing are not supported.
+ *
+ * @param[in] node:     written node (or nullptr)
+ */
+void FormulaBundle::_WriteNode(AST* node) {
+    if(node == nullptr) {
+        this->_Write<std::uint8_t>(0);
+        return;
+    }
+    this->_Write<std::uint8_t>(1);
+    this->_Write<std::int32_t>(node->kind);
+    this->_Write<std::uint64_t>(node->tag);
+    this->_Write<std::uint64_t>(node->fixpoint_number);
+    this->_Write<std::uint64_t>(node->fixpoints_from_root);
+    this->_Write<std::uint64_t>(node->height);
+    this->_Write<std::uint64_t>(node->dag_height);
+    this->_Write<std::uint64_t>(node->size);
+    this->_Write<std::uint8_t>(node->is_restriction | (node->under_complement << 1) | (node->epsilon_in << 2) | (node->is_cluster_product << 3));
+
+    switch(node->kind) {
+        case aVar1:
+        case aInt:
+            this->_Write<std::int32_t>(static_cast<ASTTerm1_n*>(node)->n);
+            break;
+        case aPlus1:
+        case aMinus1:
+            this->_WriteNode(static_cast<ASTTerm1_tn*>(node)->t);
+            this->_Write<std::int32_t>(static_cast<ASTTerm1_tn*>(node)->n);
+            break;
+        case aPlusModulo1:
+        case aMinusModulo1:
+            this->_WriteNode(static_cast<ASTTerm1_tnt*>(node)->t1);
+            this->_Write<std::int32_t>(static_cast<ASTTerm1_tnt*>(node)->n);
+            this->_WriteNode(static_cast<ASTTerm1_tnt*>(node)->t2);
+            break;
+        case aMin:
+        case aMax:
+            this->_WriteNode(static_cast<ASTTerm1_T*>(node)->T);
+            break;
+        case aVar2:
+            this->_Write<std::int32_t>(static_cast<ASTTerm2_Var2*>(node)->n);
+            break;
+        case aUnion:
+        case aInter:
+        case aSetminus:
+            this->_WriteNode(static_cast<ASTTerm2_TT*>(node)->T1);
+            this->_WriteNode(static_cast<ASTTerm2_TT*>(node)->T2);
+            break;
+        case aSet: {
+            ASTList* elements = static_cast<ASTTerm2_Set*>(node)->elements;
+            this->_Write<std::uint32_t>(elements->size());
+            for(auto it = elements->begin(); it != elements->end(); ++it) {
+                this->_WriteNode(*it);
+            }
+            break;
+        }
+        case aPlus2:
+        case aMinus2:
+            this->_WriteNode(static_cast<ASTTerm2_Tn*>(node)->T);
+            this->_Write<std::int32_t>(static_cast<ASTTerm2_Tn*>(node)->n);
+            break;
+        case aInterval:
+            this->_WriteNode(static_cast<ASTTerm2_Interval*>(node)->t1);
+            this->_WriteNode(static_cast<ASTTerm2_Interval*>(node)->t2);
+            break;
+        case aPresbConst:
+            this->_Write<std::int32_t>(static_cast<ASTTerm2_PresbConst*>(node)->value);
+            break;
+        case aVar0:
+            this->_Write<std::int32_t>(static_cast<ASTForm_Var0*>(node)->n);
+            break;
+        case aEmpty:
+        case aTrue:
+        case aFalse:
+        case aAllPos:
+            break;
+        case aIn:
+        case aNotin:
+            this->_WriteNode(static_cast<ASTForm_tT*>(node)->t1);
+            this->_WriteNode(static_cast<ASTForm_tT*>(node)->T2);
+            break;
+        case aEmptyPred:
+            this->_WriteNode(static_cast<ASTForm_T*>(node)->T);
+            break;
+        case aFirstOrder:
+            this->_WriteNode(static_cast<ASTForm_FirstOrder*>(node)->t);
+            break;
+        case aSub:
+        case aEqual2:
+        case aNotEqual2:
+            this->_WriteNode(static_cast<ASTForm_TT*>(node)->T1);
+            this->_WriteNode(static_cast<ASTForm_TT*>(node)->T2);
+            break;
+        case aEqual1:
+        case aNotEqual1:
+        case aLess:
+        case aLessEq:
+            this->_WriteNode(static_cast<ASTForm_tt*>(node)->t1);
+            this->_WriteNode(static_cast<ASTForm_tt*>(node)->t2);
+            break;
+        case aImpl:
+        case aBiimpl:
+        case aAnd:
+        case aIdLeft:
+        case aOr:
+            this->_WriteNode(static_cast<ASTForm_ff*>(node)->f1);
+            this->_WriteNode(static_cast<ASTForm_ff*>(node)->f2);
+            break;
+        case aNot:
+            this->_WriteNode(static_cast<ASTForm_Not*>(node)->f);
+            break;
+        case aRestrict:
+            this->_WriteNode(static_cast<ASTForm_f*>(node)->f);
+            break;
+        case aEx0:
+        case aAll0:
+            this->_WriteIdents(static_cast<ASTForm_vf*>(node)->vl);
+            this->_WriteNode(static_cast<ASTForm_vf*>(node)->f);
+            break;
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2:
+            this->_WriteIdents(static_cast<ASTForm_uvf*>(node)->ul);
+            this->_WriteIdents(static_cast<ASTForm_uvf*>(node)->vl);
+            this->_WriteNode(static_cast<ASTForm_uvf*>(node)->f);
+            break;
+        default:
+            throw BundleException("unsupported node of kind " + std::to_string(node->kind));
+    }
+}
+
+/**
+ * Writes the identifiers in order of their declaration, so they get the same idents when restored. Restrictions
+ * of the variables follow after all of the identifiers.
+ */
+void FormulaBundle::_WriteSymbolTable() {
+    this->_Write<std::uint32_t>(symbolTable.noIdents);
+    for(Ident ident = 0; ident < static_cast<Ident>(symbolTable.noIdents); ++ident) {
+        MonaTypeTag type = symbolTable.lookupType(ident);
+        if(type == Univname || type == Statespacename || type == Typename) {
+            throw BundleException("universes and types are not supported");
+        }
+        this->_Write<std::int32_t>(type);
+        this->_WriteString(symbolTable.lookupSymbol(ident));
+        if(isVariable(type)) {
+            this->_Write<std::uint8_t>(symbolTable.lookupImplicit(ident));
+            this->_WriteIdents(symbolTable.lookupUnivs(ident));
+        }
+    }
+
+    for(Ident ident = 0; ident < static_cast<Ident>(symbolTable.noIdents); ++ident) {
+        if(isVariable(symbolTable.lookupType(ident))) {
+            this->_WriteNode(symbolTable.lookupRestriction(ident));
+        }
+    }
+
+    Ident formal;
+    ASTForm* restriction = symbolTable.getDefault1Restriction(&formal);
+    this->_Write<std::int32_t>(restriction != nullptr ? formal : -1);
+    this->_WriteNode(restriction);
+    restriction = symbolTable.getDefault2Restriction(&formal);
+    this->_Write<std::int32_t>(restriction != nullptr ? formal : -1);
+    this->_WriteNode(restriction);
+}
+
+void FormulaBundle::_WriteTracks() {
+    this->_Write<std::uint32_t>(varMap.TrackLength());
+    for(unsigned int track = 0; track < varMap.TrackLength(); ++track) {
+        this->_Write<std::int32_t>(varMap.inverseGet(track));
+    }
+}
+
+template<class Value>
+Value FormulaBundle::_Read() {
+    if(static_cast<size_t>(this->_end - this->_cursor) < sizeof(Value)) {
+        throw BundleException("unexpected end of bundle");
+    }
+    Value value;
+    std::memcpy(&value, this->_cursor, sizeof(Value));
+    this->_cursor += sizeof(Value);
+    return value;
+}
+
+/**
+ * @return  copy of the read string allocated for the symbol table
+ */
+char* FormulaBundle::_ReadString() {
+    std::uint32_t length = this->_Read<std::uint32_t>();
+    if(length == NullString) {
+        return nullptr;
+    } else if(static_cast<size_t>(this->_end - this->_cursor) < length) {
+        throw BundleException("unexpected end of bundle");
+    }
+    char* str = new char[length + 1];
+    std::memcpy(str, this->_cursor, length);
+    str[length] = '\0';
+    this->_cursor += length;
+    return str;
+}
+
+Ident FormulaBundle::_ReadIdent() {
+    Ident ident = this->_Read<std::int32_t>();
+    if(ident < 0 || ident >= static_cast<Ident>(symbolTable.noIdents)) {
+        throw BundleException("invalid identifier");
+    }
+    return ident;
+}
+
+IdentList* FormulaBundle::_ReadIdents() {
+    std::uint32_t size = this->_Read<std::uint32_t>();
+    if(size == NullString) {
+        return nullptr;
+    }
+    IdentList* idents = new IdentList();
+    for(std::uint32_t i = 0; i < size; ++i) {
+        idents->push_back(this->_ReadIdent());
+    }
+    return idents;
+}
+
+/**
+ * Rebuilds the node written by _WriteNode() together with its subnodes. Arguments of the constructors are read
+ * beforehand, since the order of evaluation of the arguments is unspecified.
+ *
+ * @return  rebuilt node (or nullptr)
+ */
+AST* FormulaBundle::_ReadNode() {
+    if(this->_Read<std::uint8_t>() == 0) {
+        return nullptr;
+    }
+    std::int32_t kind = this->_Read<std::int32_t>();
+    size_t tag = this->_Read<std::uint64_t>();
+    size_t fixpointNumber = this->_Read<std::uint64_t>();
+    size_t fixpointsFromRoot = this->_Read<std::uint64_t>();
+    size_t height = this->_Read<std::uint64_t>();
+    size_t dagHeight = this->_Read<std::uint64_t>();
+    size_t size = this->_Read<std::uint64_t>();
+    std::uint8_t flags = this->_Read<std::uint8_t>();
+
+    AST* node;
+    switch(kind) {
+        case aVar1:
+            node = new ASTTerm1_Var1(this->_ReadIdent(), Pos());
+            break;
+        case aInt:
+            node = new ASTTerm1_Int(this->_Read<std::int32_t>(), Pos());
+            break;
+        case aPlus1:
+        case aMinus1: {
+            ASTTerm1* t = this->_ReadTerm1();
+            int n = this->_Read<std::int32_t>();
+            node = (kind == aPlus1 ? static_cast<AST*>(new ASTTerm1_Plus(t, n, Pos())) :
+                                     static_cast<AST*>(new ASTTerm1_Minus(t, n, Pos())));
+            break;
+        }
+        case aPlusModulo1:
+        case aMinusModulo1: {
+            ASTTerm1* t1 = this->_ReadTerm1();
+            int n = this->_Read<std::int32_t>();
+            ASTTerm1* t2 = this->_ReadTerm1();
+            node = (kind == aPlusModulo1 ? static_cast<AST*>(new ASTTerm1_PlusModulo(t1, n, t2, Pos())) :
+                                           static_cast<AST*>(new ASTTerm1_MinusModulo(t1, n, t2, Pos())));
+            break;
+        }
+        case aMin:
+        case aMax: {
+            ASTTerm2* T = this->_ReadTerm2();
+            node = (kind == aMin ? static_cast<AST*>(new ASTTerm1_Min(T, Pos())) :
+                                   static_cast<AST*>(new ASTTerm1_Max(T, Pos())));
+            break;
+        }
+        case aVar2:
+            node = new ASTTerm2_Var2(this->_ReadIdent(), Pos());
+            break;
+        case aEmpty:
+            node = new ASTTerm2_Empty(Pos());
+            break;
+        case aUnion:
+        case aInter:
+        case aSetminus: {
+            ASTTerm2* T1 = this->_ReadTerm2();
+            ASTTerm2* T2 = this->_ReadTerm2();
+            if(kind == aUnion) {
+                node = new ASTTerm2_Union(T1, T2, Pos());
+            } else if(kind == aInter) {
+                node = new ASTTerm2_Inter(T1, T2, Pos());
+            } else {
+                node = new ASTTerm2_Setminus(T1, T2, Pos());
+            }
+            break;
+        }
+        case aSet: {
+            std::uint32_t count = this->_Read<std::uint32_t>();
+            ASTList* elements = new ASTList();
+            for(std::uint32_t i = 0; i < count; ++i) {
+                elements->push_back(this->_ReadTerm1());
+            }
+            node = new ASTTerm2_Set(elements, Pos());
+            break;
+        }
+        case aPlus2:
+        case aMinus2: {
+            ASTTerm2* T = this->_ReadTerm2();
+            int n = this->_Read<std::int32_t>();
+            node = (kind == aPlus2 ? static_cast<AST*>(new ASTTerm2_Plus(T, n, Pos())) :
+                                     static_cast<AST*>(new ASTTerm2_Minus(T, n, Pos())));
+            break;
+        }
+        case aInterval: {
+            ASTTerm1* t1 = this->_ReadTerm1();
+            ASTTerm1* t2 = this->_ReadTerm1();
+            node = new ASTTerm2_Interval(t1, t2, Pos());
+            break;
+        }
+        case aPresbConst:
+            node = new ASTTerm2_PresbConst(this->_Read<std::int32_t>(), Pos());
+            break;
+        case aVar0:
+            node = new ASTForm_Var0(this->_ReadIdent(), Pos());
+            break;
+        case aTrue:
+            node = new ASTForm_True(Pos());
+            break;
+        case aFalse:
+            node = new ASTForm_False(Pos());
+            break;
+        case aAllPos:
+            node = new ASTForm_AllPosVar(Pos());
+            break;
+        case aIn:
+        case aNotin: {
+            ASTTerm1* t1 = this->_ReadTerm1();
+            ASTTerm2* T2 = this->_ReadTerm2();
+            node = (kind == aIn ? static_cast<AST*>(new ASTForm_In(t1, T2, Pos())) :
+                                  static_cast<AST*>(new ASTForm_Notin(t1, T2, Pos())));
+            break;
+        }
+        case aEmptyPred:
+            node = new ASTForm_EmptyPred(this->_ReadTerm2(), Pos());
+            break;
+        case aFirstOrder:
+            node = new ASTForm_FirstOrder(this->_ReadTerm1(), Pos());
+            break;
+        case aSub:
+        case aEqual2:
+        case aNotEqual2: {
+            ASTTerm2* T1 = this->_ReadTerm2();
+            ASTTerm2* T2 = this->_ReadTerm2();
+            if(kind == aSub) {
+                node = new ASTForm_Sub(T1, T2, Pos());
+            } else if(kind == aEqual2) {
+                node = new ASTForm_Equal2(T1, T2, Pos());
+            } else {
+                node = new ASTForm_NotEqual2(T1, T2, Pos());
+            }
+            break;
+        }
+        case aEqual1:
+        case aNotEqual1:
+        case aLess:
+        case aLessEq: {
+            ASTTerm1* t1 = this->_ReadTerm1();
+            ASTTerm1* t2 = this->_ReadTerm1();
+            if(kind == aEqual1) {
+                node = new ASTForm_Equal1(t1, t2, Pos());
+            } else if(kind == aNotEqual1) {
+                node = new ASTForm_NotEqual1(t1, t2, Pos());
+            } else if(kind == aLess) {
+                node = new ASTForm_Less(t1, t2, Pos());
+            } else {
+                node = new ASTForm_LessEq(t1, t2, Pos());
+            }
+            break;
+        }
+        case aImpl:
+        case aBiimpl:
+        case aAnd:
+        case aIdLeft:
+        case aOr: {
+            ASTForm* f1 = this->_ReadForm();
+            ASTForm* f2 = this->_ReadForm();
+            if(kind == aImpl) {
+                node = new ASTForm_Impl(f1, f2, Pos());
+            } else if(kind == aBiimpl) {
+                node = new ASTForm_Biimpl(f1, f2, Pos());
+            } else if(kind == aAnd) {
+                node = new ASTForm_And(f1, f2, Pos());
+            } else if(kind == aIdLeft) {
+                node = new ASTForm_IdLeft(f1, f2, Pos());
+            } else {
+                node = new ASTForm_Or(f1, f2, Pos());
+            }
+            break;
+        }
+        case aNot:
+            node = new ASTForm_Not(this->_ReadForm(), Pos());
+            break;
+        case aRestrict:
+            node = new ASTForm_Restrict(this->_ReadForm(), Pos());
+            break;
+        case aEx0:
+        case aAll0: {
+            IdentList* vl = this->_ReadIdents();
+            ASTForm* f = this->_ReadForm();
+            node = (kind == aEx0 ? static_cast<AST*>(new ASTForm_Ex0(vl, f, Pos())) :
+                                   static_cast<AST*>(new ASTForm_All0(vl, f, Pos())));
+            break;
+        }
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2: {
+            IdentList* ul = this->_ReadIdents();
+            IdentList* vl = this->_ReadIdents();
+            ASTForm* f = this->_ReadForm();
+            if(kind == aEx1) {
+                node = new ASTForm_Ex1(ul, vl, f, Pos());
+            } else if(kind == aEx2) {
+                node = new ASTForm_Ex2(ul, vl, f, Pos());
+            } else if(kind == aAll1) {
+                node = new ASTForm_All1(ul, vl, f, Pos());
+            } else {
+                node = new ASTForm_All2(ul, vl, f, Pos());
+            }
+            break;
+        }
+        default:
+            throw BundleException("unsupported node of kind " + std::to_string(kind));
+    }
+
+    // Attributes computed by the preprocessing (and constructors) are overwritten by the stored ones
+    node->tag = tag;
+    node->fixpoint_number = fixpointNumber;
+    node->fixpoints_from_root = fixpointsFromRoot;
+    node->height = height;
+    node->dag_height = dagHeight;
+    node->size = size;
+    node->is_restriction = flags & 1;
+    node->under_complement = flags & 2;
+    node->epsilon_in = flags & 4;
+    node->is_cluster_product = flags & 8;
+    return node;
+}
+
+/**
+ * @param[in] optional:     whether the formula can be missing
+ * @return  read formula
+ */
+ASTForm* FormulaBundle::_ReadForm(bool optional) {
+    AST* node = this->_ReadNode();
+    if((node == nullptr && !optional) || (node != nullptr && node->order != oForm)) {
+        throw BundleException("formula was expected");
+    }
+    return static_cast<ASTForm*>(node);
+}
+
+ASTTerm1* FormulaBundle::_ReadTerm1() {
+    AST* node = this->_ReadNode();
+    if(node == nullptr || node->order != oTerm1) {
+        throw BundleException("first order term was expected");
+    }
+    return static_cast<ASTTerm1*>(node);
+}
+
+ASTTerm2* FormulaBundle::_ReadTerm2() {
+    AST* node = this->_ReadNode();
+    if(node == nullptr || node->order != oTerm2) {
+        throw BundleException("second order term was expected");
+    }
+    return static_cast<ASTTerm2*>(node);
+}
+
+/**
+ * Restores the identifiers in order of their declaration, followed by the restrictions of the variables and the
+ * default restrictions
+ */
+void FormulaBundle::_ReadSymbolTable() {
+    std::uint32_t count = this->_Read<std::uint32_t>();
+    for(std::uint32_t i = 0; i < count; ++i) {
+        std::int32_t type = this->_Read<std::int32_t>();
+        if(type < Varname0 || type > Typename) {
+            throw BundleException("invalid type of identifier");
+        }
+        char* name = this->_ReadString();
+        if(isVariable(static_cast<MonaTypeTag>(type))) {
+            bool implicit = this->_Read<std::uint8_t>();
+            IdentList* univs = nullptr;
+            // Universes are validated after all of the identifiers are restored
+            std::uint32_t size = this->_Read<std::uint32_t>();
+            if(size != NullString) {
+                univs = new IdentList();
+                for(std::uint32_t j = 0; j < size; ++j) {
+                    univs->push_back(this->_Read<std::int32_t>());
+                }
+            }
+            symbolTable.restoreEntry(name, static_cast<MonaTypeTag>(type), univs, implicit);
+        } else {
+            symbolTable.restoreEntry(name, static_cast<MonaTypeTag>(type), nullptr, false);
+        }
+    }
+
+    for(Ident ident = 0; ident < static_cast<Ident>(symbolTable.noIdents); ++ident) {
+        if(isVariable(symbolTable.lookupType(ident))) {
+            IdentList* univs = symbolTable.lookupUnivs(ident);
+            if(univs != nullptr) {
+                for(auto it = univs->begin(); it != univs->end(); ++it) {
+                    if(*it < 0 || *it >= static_cast<Ident>(symbolTable.noIdents)) {
+                        throw BundleException("invalid identifier");
+                    }
+                }
+            }
+            ASTForm* restriction = this->_ReadForm(true);
+            if(restriction != nullptr) {
+                symbolTable.updateRestriction(ident, restriction);
+            }
+        }
+    }
+
+    for(MonaTypeTag type : {Varname1, Varname2}) {
+        Ident formal = this->_Read<std::int32_t>();
+        ASTForm* restriction = this->_ReadForm(true);
+        if(restriction != nullptr) {
+            if(formal < 0 || formal >= static_cast<Ident>(symbolTable.noIdents)) {
+                throw BundleException("invalid identifier");
+            }
+            symbolTable.setDefaultRestriction(type, restriction, formal);
+        }
+    }
+}
+
+void FormulaBundle::_ReadTracks() {
+    std::uint32_t length = this->_Read<std::uint32_t>();
+    varMap.clear();
+    for(std::uint32_t track = 0; track < length; ++track) {
+        varMap.insert(this->_ReadIdent(), track);
+    }
+    // Tracks could be reordered when the bundle was compiled
+    varMap.AlignOffsets();
+}
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: FormulaBundle.h
+ *  Description:
+ *      Precompiled formula bundles. The bundle holds the preprocessed and
+ *      tagged formula, the root restriction, the symbol table and the tracks
+ *      of the variables, so the repeated decisions of the same formula can
+ *      start right at the construction of the automaton. The bundle is
+ *      mapped into memory and the nodes of the formula are rebuilt in the
+ *      single pass over it.
+ *
+ *      Bundles are bound to the build of gaston that compiled them and to
+ *      the options that affect the preprocessing (-cfX, -icfX, --test).
+ *      Only WS1S and M2L-STR formulae are supported.
+ *****************************************************************************/
+
+#ifndef WSKS_FORMULABUNDLE_H
+#define WSKS_FORMULABUNDLE_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "../../Frontend/ast.h"
+
+class FormulaBundle {
+private:
+    // <<< PRIVATE MEMBERS >>>
+    std::string _buffer;                    // < Written content of the bundle
+    const char* _cursor = nullptr;          // < Position of the reading in the mapped bundle
+    const char* _end = nullptr;             // < End of the mapped bundle
+
+    // <<< PRIVATE METHODS >>>
+    template<class Value>
+    void _Write(Value);
+    void _WriteString(const char*);
+    void _WriteIdents(IdentList*);
+    void _WriteNode(AST*);
+    void _WriteSymbolTable();
+    void _WriteTracks();
+
+    template<class Value>
+    Value _Read();
+    char* _ReadString();
+    Ident _ReadIdent();
+    IdentList* _ReadIdents();
+    AST* _ReadNode();
+    ASTForm* _ReadForm(bool optional = false);
+    ASTTerm1* _ReadTerm1();
+    ASTTerm2* _ReadTerm2();
+    void _ReadSymbolTable();
+    void _ReadTracks();
+
+public:
+    struct BundleException : public std::runtime_error {
+        explicit BundleException(const std::string& what) : std::runtime_error(what) {}
+    };
+
+    // <<< PUBLIC API >>>
+    static bool IsBundle(const char*);
+    static bool Compile(const char*, MonaAST*, ASTForm*, bool);
+    static MonaAST* Load(const char*, ASTForm*&, bool&);
+};
+
+#endif //WSKS_FORMULABUNDLE_H
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Snapshots of the statistics of the running decision procedure
+ *****************************************************************************/
+
+#include "LiveStats.h"
+#include "ResourceGovernor.h"
+#include "Symbol.h"
+#include "../containers/Term.h"
+#include <iomanip>
+#include <iostream>
+
+volatile std::sig_atomic_t LiveStats::requested = 0;
+size_t LiveStats::cacheHits[LiveStats::_categoryCount] = {0};
+size_t LiveStats::cacheMisses[LiveStats::_categoryCount] = {0};
+std::vector<LiveStats::Phase> LiveStats::_phases;
+size_t LiveStats::_snapshots = 0;
+
+/**
+ * Installs the handler of SIGUSR1 requesting the snapshot
+ */
+void LiveStats::Install() {
+    signal(SIGUSR1, LiveStats::Request);
+}
+
+/**
+ * Starts the new phase @p name of the run, ending the previous one. Phase change is safe point as well.
+ *
+ * @param[in] name:     name of the phase (has to be static string)
+ */
+void LiveStats::EnterPhase(const char* name) {
+    _phases.push_back(Phase{name, ClockType::now()});
+    Check();
+}
+
+void LiveStats::Dump() {
+    Dump(std::cerr);
+    std::cerr.flush();
+}
+
+/**
+ * Prints the snapshot of the current phase, elapsed times of phases, created terms, active fixpoints,
+ * hit rates of the caches and accounted memory to @p os. Formatting of @p os is restored afterwards.
+ *
+ * @param[in] os:   output stream
+ */
+void LiveStats::Dump(std::ostream& os) {
+    auto now = ClockType::now();
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "[*] Live statistics (snapshot #" << ++_snapshots << ", " << ResourceGovernor::GetSteps() << " steps):\n";
+
+    // Phases
+    os << std::fixed << std::setprecision(3);
+    os << "\t∘ Phase: " << (_phases.empty() ? "init" : _phases.back().name) << "\n";
+    for(size_t i = 0; i < _phases.size(); ++i) {
+        auto end = (i + 1 == _phases.size() ? now : _phases[i + 1].start);
+        os << "\t\t" << std::left << std::setw(16) << _phases[i].name << std::right
+           << std::chrono::duration<double>(end - _phases[i].start).count() << "s\n";
+    }
+
+    // Terms
+#   if (MEASURE_STATE_SPACE == true)
+    os << "\t∘ Terms: " << TermEmpty::instances << " empty, " << TermBaseSet::instances << " bases, ";
+    os << TermProduct::instances << " products, " << TermTernaryProduct::instances << " ternary products, ";
+    os << TermNaryProduct::instances << " nary products, " << TermList::instances << " lists, ";
+    os << TermFixpoint::instances << " fixpoints, " << TermContinuation::instances << " continuations\n";
+#   endif
+#   if (MEASURE_SYMBOLS == true)
+    os << "\t∘ Symbols: " << ZeroSymbol::instances << "\n";
+#   endif
+    TermFixpoint::DumpActive(os, OPT_LIVE_STATS_TOP_FIXPOINTS);
+
+    // Caches
+#   if (MEASURE_LIVE_CACHE_HITS == true)
+    os << "\t∘ Cache hit rates:\n";
+    for(size_t i = 0; i < _categoryCount; ++i) {
+        size_t lookups = cacheHits[i] + cacheMisses[i];
+        if(lookups != 0) {
+            os << "\t\t" << std::left << std::setw(24) << MemoryAccounting::CategoryToString(static_cast<MemoryCategory>(i))
+               << std::right << std::setprecision(2) << (100.0*cacheHits[i]/lookups) << "% (" << cacheHits[i] << ":"
+               << cacheMisses[i] << ")\n";
+        }
+    }
+#   endif
+
+    // Memory
+    os << "\t∘ Peak memory: " << ResourceGovernor::GetPeakMemory() << "kB\n";
+#   if (MEASURE_MEMORY == true)
+    MemoryAccounting::Dump(os);
+#   endif
+    os.flags(flags);
+    os.precision(precision);
+}
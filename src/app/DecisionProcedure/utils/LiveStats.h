@@ -0,0 +1,78 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: LiveStats.h
+ *  Description:
+ *      Snapshots of the statistics of the running decision procedure on
+ *      demand. The SIGUSR1 handler only raises the flag, the snapshot is
+ *      printed (to stderr) at the next safe point or phase change, so the
+ *      printed state is consistent and the computation goes on.
+ *****************************************************************************/
+
+#ifndef WSKS_LIVESTATS_H
+#define WSKS_LIVESTATS_H
+
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+#include "MemoryAccounting.h"
+#include "../environment.hh"
+
+class LiveStats {
+private:
+    using ClockType = std::chrono::steady_clock;
+
+    struct Phase {
+        const char* name;
+        ClockType::time_point start;
+    };
+
+    static const size_t _categoryCount = static_cast<size_t>(MemoryCategory::CATEGORY_COUNT);
+    static std::vector<Phase> _phases;              // < Entered phases in order, the last one is current
+    static size_t _snapshots;                       // < Number of printed snapshots
+
+public:
+    static volatile std::sig_atomic_t requested;    // < Snapshot was requested by signal
+    static size_t cacheHits[_categoryCount];        // < Hits of the caches by their category
+    static size_t cacheMisses[_categoryCount];      // < Misses of the caches by their category
+
+    static void Install();
+    static void Request(int) { requested = 1; }
+    static void EnterPhase(const char* name);
+
+    /**
+     * Counts the lookup to the cache of @p category, compiled out unless MEASURE_LIVE_CACHE_HITS is set
+     */
+    static inline void CountLookup(MemoryCategory category, bool hit) {
+#       if (MEASURE_LIVE_CACHE_HITS == true)
+        ++(hit ? cacheHits : cacheMisses)[static_cast<size_t>(category)];
+#       endif
+    }
+
+    /**
+     * Prints the snapshot if it was requested, called at safe points
+     */
+    static inline void Check() {
+        if(requested) {
+            requested = 0;
+            Dump();
+        }
+    }
+
+    static void Dump();
+    static void Dump(std::ostream&);
+};
+
+#endif //WSKS_LIVESTATS_H
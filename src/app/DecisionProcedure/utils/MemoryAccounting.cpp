@@ -0,0 +1,123 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Accounting of the memory of the decision procedure by subsystems
+ *****************************************************************************/
+
+#include "MemoryAccounting.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+size_t MemoryAccounting::_live[MemoryAccounting::_categoryCount] = {0};
+size_t MemoryAccounting::_peak[MemoryAccounting::_categoryCount] = {0};
+size_t MemoryAccounting::_liveTotal = 0;
+size_t MemoryAccounting::_peakTotal = 0;
+std::ofstream* MemoryAccounting::_snapshots = nullptr;
+unsigned long MemoryAccounting::_openedAt = 0;
+unsigned long MemoryAccounting::_lastSnapshot = 0;
+
+/**
+ * @return  monotonic time in ms
+ */
+unsigned long MemoryAccounting::_NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* MemoryAccounting::CategoryToString(MemoryCategory category) {
+    switch(category) {
+        case MemoryCategory::TERM_EMPTY: return "term empty";
+        case MemoryCategory::TERM_BASE: return "term bases";
+        case MemoryCategory::TERM_PRODUCT: return "term products";
+        case MemoryCategory::TERM_TERNARY_PRODUCT: return "term ternary products";
+        case MemoryCategory::TERM_NARY_PRODUCT: return "term nary products";
+        case MemoryCategory::TERM_LIST: return "term lists";
+        case MemoryCategory::TERM_FIXPOINT: return "term fixpoints";
+        case MemoryCategory::TERM_CONTINUATION: return "term continuations";
+        case MemoryCategory::RESULT_CACHE: return "result caches";
+        case MemoryCategory::SUBSUMPTION_CACHE: return "subsumption caches";
+        case MemoryCategory::PRE_CACHE: return "pre caches";
+        case MemoryCategory::WRAPPER_CACHE: return "mona wrapper caches";
+        case MemoryCategory::DAG_CACHE: return "dag caches";
+        case MemoryCategory::OTHER_CACHE: return "workshop caches";
+        case MemoryCategory::SYMBOLS: return "symbols";
+        case MemoryCategory::MONA_DFA: return "mona dfas";
+        case MemoryCategory::AST_NODES: return "ast nodes";
+        default: return "unknown";
+    }
+}
+
+/**
+ * Dumps the table of live and peak bytes of all of the categories to @p os
+ *
+ * @param[in] os:   output stream
+ */
+void MemoryAccounting::Dump(std::ostream& os) {
+    os << "[*] Memory Accounting (live / peak kB):\n";
+    for(size_t i = 0; i < _categoryCount; ++i) {
+        os << "\t∘ " << std::left << std::setw(24) << CategoryToString(static_cast<MemoryCategory>(i)) << std::right
+           << std::setw(10) << (_live[i] >> 10) << " / " << (_peak[i] >> 10) << "\n";
+    }
+    os << "\t∘ " << std::left << std::setw(24) << "total" << std::right
+       << std::setw(10) << (_liveTotal >> 10) << " / " << (_peakTotal >> 10) << "\n";
+}
+
+/**
+ * Opens the file @p filename for periodic snapshots of the accounting. Snapshots are written
+ * as tab separated rows of live bytes of the categories.
+ *
+ * @param[in] filename:     name of the output file
+ */
+void MemoryAccounting::OpenSnapshots(const char* filename) {
+    _snapshots = new std::ofstream(filename);
+    *_snapshots << "ms";
+    for(size_t i = 0; i < _categoryCount; ++i) {
+        *_snapshots << "\t" << CategoryToString(static_cast<MemoryCategory>(i));
+    }
+    *_snapshots << "\ttotal\n";
+    _openedAt = _lastSnapshot = _NowMs();
+    Snapshot(true);
+}
+
+/**
+ * Writes the snapshot of live bytes, if at least OPT_MEMORY_SNAPSHOT_PERIOD ms elapsed
+ * since the last one (or if @p force is set)
+ *
+ * @param[in] force:    writes the snapshot regardless of the period
+ */
+void MemoryAccounting::Snapshot(bool force) {
+    if(_snapshots == nullptr) {
+        return;
+    }
+    unsigned long now = _NowMs();
+    if(!force && now - _lastSnapshot < OPT_MEMORY_SNAPSHOT_PERIOD) {
+        return;
+    }
+    _lastSnapshot = now;
+    *_snapshots << (now - _openedAt);
+    for(size_t i = 0; i < _categoryCount; ++i) {
+        *_snapshots << "\t" << _live[i];
+    }
+    *_snapshots << "\t" << _liveTotal << "\n";
+}
+
+void MemoryAccounting::CloseSnapshots() {
+    if(_snapshots != nullptr) {
+        Snapshot(true);
+        _snapshots->close();
+        delete _snapshots;
+        _snapshots = nullptr;
+    }
+}
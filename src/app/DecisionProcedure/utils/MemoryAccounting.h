@@ -0,0 +1,100 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: MemoryAccounting.h
+ *  Description:
+ *      Accounting of the live and peak bytes of the data structures of the
+ *      decision procedure by their category (terms, caches, symbols, dfas
+ *      and ast nodes). The sizes are estimates of the footprint (object and
+ *      its owned storage), not the exact size of the allocated blocks.
+ *****************************************************************************/
+
+#ifndef WSKS_MEMORYACCOUNTING_H
+#define WSKS_MEMORYACCOUNTING_H
+
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+#include "../environment.hh"
+
+enum class MemoryCategory : unsigned int {
+    TERM_EMPTY, TERM_BASE, TERM_PRODUCT, TERM_TERNARY_PRODUCT, TERM_NARY_PRODUCT, TERM_LIST, TERM_FIXPOINT, TERM_CONTINUATION,
+    RESULT_CACHE, SUBSUMPTION_CACHE, PRE_CACHE, WRAPPER_CACHE, DAG_CACHE, OTHER_CACHE,
+    SYMBOLS, MONA_DFA, AST_NODES,
+    CATEGORY_COUNT
+};
+
+class MemoryAccounting {
+private:
+    static const size_t _categoryCount = static_cast<size_t>(MemoryCategory::CATEGORY_COUNT);
+    static size_t _live[_categoryCount];            // < Currently accounted bytes
+    static size_t _peak[_categoryCount];            // < Maximal accounted bytes
+    static size_t _liveTotal;
+    static size_t _peakTotal;
+    static std::ofstream* _snapshots;               // < File with periodic snapshots (or nullptr)
+    static unsigned long _openedAt;                 // < Time of the opening of the snapshots in ms
+    static unsigned long _lastSnapshot;             // < Time of the last snapshot in ms
+
+    static unsigned long _NowMs();
+
+public:
+    static inline void Allocate(MemoryCategory category, size_t bytes) {
+#       if (MEASURE_MEMORY == true)
+        size_t idx = static_cast<size_t>(category);
+        _live[idx] += bytes;
+        _liveTotal += bytes;
+        if(_live[idx] > _peak[idx]) {
+            _peak[idx] = _live[idx];
+        }
+        if(_liveTotal > _peakTotal) {
+            _peakTotal = _liveTotal;
+        }
+#       endif
+    }
+
+    static inline void Release(MemoryCategory category, size_t bytes) {
+#       if (MEASURE_MEMORY == true)
+        size_t idx = static_cast<size_t>(category);
+        // Releasing more than was allocated is a double release or mismatched category
+        assert(bytes <= _live[idx]);
+        bytes = (bytes > _live[idx] ? _live[idx] : bytes);
+        _live[idx] -= bytes;
+        _liveTotal -= bytes;
+#       endif
+    }
+
+    /**
+     * Changes the accounted footprint of some structure from @p accounted to @p bytes
+     */
+    static inline void Resize(MemoryCategory category, size_t& accounted, size_t bytes) {
+        if(bytes > accounted) {
+            Allocate(category, bytes - accounted);
+        } else {
+            Release(category, accounted - bytes);
+        }
+        accounted = bytes;
+    }
+
+    static size_t GetLive(MemoryCategory category) { return _live[static_cast<size_t>(category)]; }
+    static size_t GetPeak(MemoryCategory category) { return _peak[static_cast<size_t>(category)]; }
+    static size_t GetLiveTotal() { return _liveTotal; }
+    static const char* CategoryToString(MemoryCategory);
+
+    static void Dump(std::ostream&);
+    static void OpenSnapshots(const char* filename);
+    static void Snapshot(bool force = false);
+    static void CloseSnapshots();
+    static void DetachSnapshots() { _snapshots = nullptr; }    // < Forked workers never write to the stream of the parent
+};
+
+#endif //WSKS_MEMORYACCOUNTING_H
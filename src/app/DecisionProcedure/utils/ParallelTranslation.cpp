@@ -0,0 +1,259 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Parallel translation of MONA code to DFA
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ParallelTranslation.h"
+#include "Tracer.h"
+#include "../containers/Workshops.h"
+#include "../environment.hh"
+#include "../../Frontend/env.h"
+
+extern Options options;
+
+/**
+ * Translates the @p root of MONA code to DFA. Unless the root is unshared conjunction (disjunction), it is
+ * translated as usual.
+ *
+ * @param[in] root:  root of the code DAG
+ * @return  DFA of the root over the variables of @p root
+ */
+DFA* ParallelTranslation::DFATranslate(VarCode& root) {
+    Code* code = root.code;
+    if((code->kind != cAnd && code->kind != cOr) || code->refs > 1 || code->dfa != nullptr) {
+        return root.DFATranslate();
+    }
+
+    Tracer::Scope traceScope("parallel translation", "mona");
+    ParallelTranslation translation;
+    translation._kind = code->kind;
+    std::vector<VarCode> path;
+    translation._Flatten(static_cast<Code_cc*>(code)->vc1, path);
+    translation._Flatten(static_cast<Code_cc*>(code)->vc2, path);
+
+    std::vector<size_t> deep;
+    for(size_t i = 0; i < translation._operands.size(); ++i) {
+        Code* operand = translation._operands[i].code->code;
+        if(operand->depth >= OPT_MONA_WORKER_MIN_DEPTH && operand->dfa == nullptr) {
+            deep.push_back(i);
+        }
+    }
+    // With single deep operand the parent would only wait for its worker
+    if(deep.size() < 2) {
+        deep.clear();
+    }
+
+    // Buffered output would be flushed by every worker as well
+    std::cout.flush();
+    fflush(stdout);
+    size_t next = 0;
+    while(next < deep.size() && translation._workers.size() < OPT_MONA_TRANSLATION_WORKERS) {
+        size_t operand = deep[next++];
+        if(!translation._StartWorker(operand)) {
+            translation._ReleaseOperand(translation._operands[operand], translation._TranslateOperand(translation._operands[operand]));
+        }
+    }
+
+    // Shallow operands are translated while the workers run
+    for(size_t i = 0; i < translation._operands.size(); ++i) {
+        if(std::find(deep.begin(), deep.end(), i) == deep.end()) {
+            translation._ReleaseOperand(translation._operands[i], translation._TranslateOperand(translation._operands[i]));
+        }
+    }
+
+    while(!translation._workers.empty()) {
+        translation._FinishWorker();
+        while(next < deep.size() && translation._workers.size() < OPT_MONA_TRANSLATION_WORKERS) {
+            size_t operand = deep[next++];
+            if(!translation._StartWorker(operand)) {
+                translation._ReleaseOperand(translation._operands[operand], translation._TranslateOperand(translation._operands[operand]));
+            }
+        }
+    }
+
+    DFA* dfa = translation._Combine(code->pos);
+    st_dfa_replace_indices(dfa, root.vars, &code->vars);
+    return dfa;
+}
+
+/**
+ * Collects the operands of the unshared nodes of the same kind as the root
+ *
+ * @param[in] vc:  collected subcode
+ * @param[in] path:  nodes between the root and @p vc
+ */
+void ParallelTranslation::_Flatten(VarCode& vc, std::vector<VarCode>& path) {
+    Code* code = vc.code;
+    if(code->kind == this->_kind && code->refs == 1 && code->dfa == nullptr) {
+        path.push_back(vc);
+        this->_Flatten(static_cast<Code_cc*>(code)->vc1, path);
+        this->_Flatten(static_cast<Code_cc*>(code)->vc2, path);
+        path.pop_back();
+    } else {
+        this->_operands.emplace_back();
+        this->_operands.back().code = &vc;
+        this->_operands.back().path = path;
+    }
+}
+
+/**
+ * Translates the @p operand and maps its DFA to the variables of the root
+ *
+ * @param[in] operand:  translated operand
+ * @return  DFA of the operand over the variables of the root node
+ */
+DFA* ParallelTranslation::_TranslateOperand(Operand& operand) {
+    DFA* dfa = operand.code->DFATranslate();
+    for(auto it = operand.path.rbegin(); it != operand.path.rend(); ++it) {
+        st_dfa_replace_indices(dfa, it->vars, &it->code->vars);
+    }
+    return dfa;
+}
+
+/**
+ * Stores the @p dfa of the @p operand and releases its code, as its parent would do after the translation.
+ * The released subcode is cleared in the parent, so the removal of the root skips it.
+ *
+ * @param[in] operand:  translated operand
+ * @param[in] dfa:  DFA of the operand over the variables of the root
+ */
+void ParallelTranslation::_ReleaseOperand(Operand& operand, DFA* dfa) {
+    operand.dfa = dfa;
+    operand.code->remove();
+}
+
+/**
+ * Forks the worker that translates the @p operand and exports its DFA
+ *
+ * @param[in] operand:  index of the translated operand
+ * @return  true if the worker was started
+ */
+bool ParallelTranslation::_StartWorker(size_t operand) {
+    Worker worker;
+    worker.operand = operand;
+    strcpy(worker.file, "/tmp/gaston-dfa-XXXXXX");
+    int fd = mkstemp(worker.file);
+    if(fd == -1) {
+        return false;
+    }
+    close(fd);
+
+    worker.pid = fork();
+    if(worker.pid == -1) {
+        unlink(worker.file);
+        return false;
+    } else if(worker.pid == 0) {
+        // Worker works on its own copy of the DAG and never returns to the parent's code
+        options.printProgress = false;
+        options.intermediate = false;
+        options.statistics = false;
+        DFA* dfa = this->_TranslateOperand(this->_operands[operand]);
+        _exit(dfaExport(dfa, worker.file, 0, nullptr, nullptr) ? 0 : 1);
+    }
+
+    this->_workers.push_back(worker);
+    return true;
+}
+
+/**
+ * Waits for any of the workers to finish and imports its DFA. Exited children are only peeked at, and just the
+ * workers' pids are reaped, so other children of the process are left to their owners. Once other child has
+ * exited, it would be reported again, so the workers are polled instead. If the worker failed, the operand is
+ * translated by the parent, as its code was left untouched.
+ */
+void ParallelTranslation::_FinishWorker() {
+    auto worker = this->_workers.end();
+    bool polling = false;
+    int status = 0;
+    int pid = 0;
+    while(worker == this->_workers.end()) {
+        if(!polling) {
+            siginfo_t info;
+            info.si_pid = 0;
+            if(waitid(P_ALL, 0, &info, WEXITED | WNOWAIT) == -1) {
+                polling = (errno != EINTR);
+                continue;
+            }
+            worker = std::find_if(this->_workers.begin(), this->_workers.end(), [&info](Worker const& w) {
+                return w.pid == info.si_pid;
+            });
+            if(worker == this->_workers.end()) {
+                polling = true;
+                continue;
+            }
+            while((pid = waitpid(worker->pid, &status, 0)) == -1 && errno == EINTR);
+        } else {
+            for(worker = this->_workers.begin(); worker != this->_workers.end(); ++worker) {
+                while((pid = waitpid(worker->pid, &status, WNOHANG)) == -1 && errno == EINTR);
+                if(pid != 0) {
+                    break;
+                }
+            }
+            if(worker == this->_workers.end()) {
+                usleep(OPT_MONA_WORKER_POLL_INTERVAL);
+            }
+        }
+    }
+    bool failed = (pid == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0);
+
+    Operand& operand = this->_operands[worker->operand];
+    DFA* dfa = nullptr;
+    if(!failed) {
+        dfa = dfaImport(worker->file, nullptr, nullptr);
+    }
+    unlink(worker->file);
+    if(dfa == nullptr) {
+        std::cout << "[!] Worker failed to translate MONA code, translating it again\n";
+        dfa = this->_TranslateOperand(operand);
+    } else {
+        // Only states of the operand are known, the nodes beneath were counted by the worker
+        Workshops::TermWorkshop::monaAutomataStates += dfa->ns;
+    }
+    this->_ReleaseOperand(operand, dfa);
+    this->_workers.erase(worker);
+}
+
+/**
+ * Combines DFAs of the operands in the balanced tree of products
+ *
+ * @param[in] pos:  position of the root
+ * @return  product of all of the operands
+ */
+DFA* ParallelTranslation::_Combine(Pos& pos) {
+    dfaProductType type = (this->_kind == cAnd ? dfaAND : dfaOR);
+    std::vector<DFA*> level;
+    for(Operand& operand : this->_operands) {
+        level.push_back(operand.dfa);
+    }
+
+    while(level.size() > 1) {
+        std::vector<DFA*> next;
+        for(size_t i = 0; i + 1 < level.size(); i += 2) {
+            next.push_back(st_dfa_minimization(st_dfa_product(level[i], level[i + 1], type, pos)));
+        }
+        if(level.size() % 2 == 1) {
+            next.push_back(level.back());
+        }
+        level.swap(next);
+    }
+    return level.front();
+}
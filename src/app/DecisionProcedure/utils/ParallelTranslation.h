@@ -0,0 +1,64 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: ParallelTranslation.h
+ *  Description:
+ *      Parallel translation of MONA code to DFA. The unshared conjunctions
+ *      (disjunctions) at the root of the code DAG are flattened to the list
+ *      of operands; the deep operands are translated in the forked workers,
+ *      as the BDD and DFA libraries of MONA keep global state, and handed
+ *      back through the exported DFAs. The shallow ones are translated by
+ *      the parent meanwhile and all of them are combined in the balanced
+ *      tree of products.
+ *****************************************************************************/
+
+#ifndef WSKS_PARALLELTRANSLATION_H
+#define WSKS_PARALLELTRANSLATION_H
+
+#include <vector>
+#include "../../Frontend/code.h"
+
+class ParallelTranslation {
+private:
+    // <<< PRIVATE TYPES >>>
+    struct Operand {
+        VarCode* code;                      // < Operand of the flattened root (the subcode held by its parent)
+        std::vector<VarCode> path;          // < Nodes between the root and the operand (innermost last)
+        DFA* dfa = nullptr;
+    };
+
+    struct Worker {
+        size_t operand;                     // < Index of the translated operand
+        int pid;
+        char file[32];                      // < Exported DFA of the operand
+    };
+
+    // <<< PRIVATE MEMBERS >>>
+    CodeKind _kind;                         // < Kind of the flattened root (cAnd or cOr)
+    std::vector<Operand> _operands;
+    std::vector<Worker> _workers;
+
+    // <<< PRIVATE METHODS >>>
+    void _Flatten(VarCode&, std::vector<VarCode>&);
+    DFA* _TranslateOperand(Operand&);
+    void _ReleaseOperand(Operand&, DFA*);
+    bool _StartWorker(size_t);
+    void _FinishWorker();
+    DFA* _Combine(Pos&);
+
+public:
+    // <<< PUBLIC API >>>
+    static DFA* DFATranslate(VarCode&);
+};
+
+#endif //WSKS_PARALLELTRANSLATION_H
@@ -0,0 +1,130 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Bounded pool of forked workers probing the emptiness of operands
+ *****************************************************************************/
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "ProbePool.h"
+#include "MemoryAccounting.h"
+#include "../../Frontend/env.h"
+
+extern Options options;
+
+size_t ProbePool::_running = 0;
+bool ProbePool::_inWorker = false;
+size_t ProbePool::started = 0;
+size_t ProbePool::foundEmpty = 0;
+
+/**
+ * @return  true if the operands can be probed, i.e. the workers are allowed and this process is not a worker
+ */
+bool ProbePool::Enabled() {
+    return options.naryWorkers != 0 && !_inWorker;
+}
+
+/**
+ * @return  true if another worker can be started without exceeding the --nary-workers option
+ */
+bool ProbePool::HasFreeWorker() const {
+    return _running < options.naryWorkers;
+}
+
+/**
+ * Forks the worker, that decides the emptiness of the @p operand by @p isEmpty. The worker exits with 0 if the
+ * operand is empty, with 1 if it is not, and with 2 if it was stopped.
+ *
+ * @param[in] operand:  index of the probed operand
+ * @param[in] isEmpty:  computation of the emptiness of the operand
+ * @return  true if the worker was started
+ */
+bool ProbePool::Start(size_t operand, std::function<bool()> const& isEmpty) {
+    // Buffered output would be flushed by the worker as well
+    std::cout.flush();
+    fflush(stdout);
+
+    int pid = fork();
+    if(pid == -1) {
+        return false;
+    } else if(pid == 0) {
+        // Worker works on its own copy of the automata and never returns to the parent's code
+        _inWorker = true;
+        options.printProgress = false;
+        options.intermediate = false;
+        options.statistics = false;
+        MemoryAccounting::DetachSnapshots();
+        signal(SIGUSR1, SIG_IGN);
+        int status = 2;
+        try {
+            status = (isEmpty() ? 0 : 1);
+        } catch (...) {
+            // Stopped by the governor or out of memory, the parent evaluates the operand itself
+        }
+        _exit(status);
+    }
+
+    this->_probes.push_back(Probe{operand, pid});
+    ++_running;
+    ++ProbePool::started;
+    return true;
+}
+
+/**
+ * Reaps the finished workers without blocking. Workers that found their operand nonempty (or failed) only free
+ * their place in the pool.
+ *
+ * @param[out] operand:  operand that was found empty
+ * @return  true if some of the finished workers found its operand empty
+ */
+bool ProbePool::TakeEmpty(size_t& operand) {
+    for(auto it = this->_probes.begin(); it != this->_probes.end();) {
+        int status = 0;
+        int pid;
+        while((pid = waitpid(it->pid, &status, WNOHANG)) == -1 && errno == EINTR);
+        if(pid == 0) {
+            ++it;
+            continue;
+        }
+
+        --_running;
+        bool empty = (pid != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        size_t probed = it->operand;
+        it = this->_probes.erase(it);
+        if(empty) {
+            ++ProbePool::foundEmpty;
+            operand = probed;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Kills and reaps all of the running workers of the pool, as their results are not needed anymore
+ */
+void ProbePool::CancelAll() {
+    for(Probe& probe : this->_probes) {
+        kill(probe.pid, SIGKILL);
+    }
+    for(Probe& probe : this->_probes) {
+        while(waitpid(probe.pid, nullptr, 0) == -1 && errno == EINTR);
+    }
+    _running -= this->_probes.size();
+    this->_probes.clear();
+}
@@ -0,0 +1,60 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: ProbePool.h
+ *  Description:
+ *      Bounded pool of forked workers, that probe the emptiness of the
+ *      operands of nary intersections. Terms, workshops and caches are not
+ *      synchronized, so each worker computes on its own copy of the process
+ *      and hands back only whether the operand is empty. Workers of all of
+ *      the pools together never exceed the --nary-workers option.
+ *****************************************************************************/
+
+#ifndef WSKS_PROBEPOOL_H
+#define WSKS_PROBEPOOL_H
+
+#include <functional>
+#include <vector>
+
+class ProbePool {
+private:
+    // <<< PRIVATE TYPES >>>
+    struct Probe {
+        size_t operand;                     // < Index of the probed operand
+        int pid;
+    };
+
+    // <<< PRIVATE MEMBERS >>>
+    std::vector<Probe> _probes;
+    static size_t _running;                 // < Number of the running workers of all of the pools
+    static bool _inWorker;                  // < True in the forked worker, which never forks further
+
+public:
+    static size_t started;                  // < Number of the forked workers
+    static size_t foundEmpty;               // < Number of the empty operands found by the workers
+
+    // <<< CONSTRUCTORS >>>
+    ProbePool() = default;
+    ProbePool(const ProbePool&) = delete;
+    ProbePool& operator=(const ProbePool&) = delete;
+    ~ProbePool() { this->CancelAll(); }
+
+    // <<< PUBLIC API >>>
+    static bool Enabled();
+    bool HasFreeWorker() const;
+    bool Start(size_t operand, std::function<bool()> const& isEmpty);
+    bool TakeEmpty(size_t& operand);
+    void CancelAll();
+};
+
+#endif //WSKS_PROBEPOOL_H
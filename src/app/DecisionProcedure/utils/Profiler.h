@@ -0,0 +1,93 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: Profiler.h
+ *  Description:
+ *      Runtime profiler of the nodes of symbolic automata, that attributes
+ *      self and inclusive time of IntersectNonEmpty to each node. Nothing
+ *      is counted while the profiler is disabled, and a node is listed at
+ *      its first call with the profiler enabled. Inclusive time is counted
+ *      only by the outermost active call of the node, so the recursion
+ *      through SymLinks is not counted twice.
+ *****************************************************************************/
+
+#ifndef WSKS_PROFILER_H
+#define WSKS_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+struct ProfileRecord {
+    std::uint64_t selfTime = 0;         // < Time spent in node without its children (in ns)
+    std::uint64_t inclusiveTime = 0;    // < Time spent in node including its children (in ns)
+    size_t calls = 0;                   // < Number of IntersectNonEmpty calls
+    size_t cacheHits = 0;               // < Number of hits in the result cache
+    size_t remappedUses = 0;            // < Number of symbols remapped through SymLinks to the node
+    size_t termsCreated = 0;            // < Number of terms created for the node
+    size_t activeCalls = 0;             // < Number of calls of the node currently on the stack
+};
+
+class AutomatonProfiler {
+private:
+    using ClockType = std::chrono::steady_clock;
+
+    struct Frame {
+        ClockType::time_point start;
+        std::uint64_t childrenTime;
+    };
+    static std::vector<Frame> _stack;
+
+    static void _Enter(ProfileRecord& record) {
+        ++record.activeCalls;
+        _stack.push_back(Frame{ClockType::now(), 0});
+    }
+
+    static void _Leave(ProfileRecord& record) {
+        Frame frame = _stack.back();
+        _stack.pop_back();
+        std::uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now() - frame.start).count();
+        if(--record.activeCalls == 0) {
+            record.inclusiveTime += elapsed;
+        }
+        record.selfTime += (elapsed > frame.childrenTime ? elapsed - frame.childrenTime : 0);
+        if(!_stack.empty()) {
+            _stack.back().childrenTime += elapsed;
+        }
+    }
+
+public:
+    static bool enabled;
+
+    /**
+     * Scope of one call of the profiled node, the time is measured only if the profiler is enabled
+     */
+    class Scope {
+    private:
+        ProfileRecord* _record;
+    public:
+        explicit Scope(ProfileRecord& record) : _record(AutomatonProfiler::enabled ? &record : nullptr) {
+            if(_record != nullptr) {
+                AutomatonProfiler::_Enter(*_record);
+            }
+        }
+        ~Scope() {
+            if(_record != nullptr) {
+                AutomatonProfiler::_Leave(*_record);
+            }
+        }
+    };
+};
+
+#endif //WSKS_PROFILER_H
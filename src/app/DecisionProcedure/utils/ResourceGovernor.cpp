@@ -0,0 +1,92 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Cooperative governor of resources of the decision procedure
+ *****************************************************************************/
+
+#include "ResourceGovernor.h"
+#include "MemoryAccounting.h"
+#include <cstdint>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+volatile std::sig_atomic_t ResourceGovernor::_interrupted = 0;
+GovernorStatus ResourceGovernor::_status = GovernorStatus::RUNNING;
+ResourceGovernor::ClockType::time_point ResourceGovernor::_deadline;
+bool ResourceGovernor::_hasDeadline = false;
+size_t ResourceGovernor::_memLimit = 0;
+size_t ResourceGovernor::_stepLimit = 0;
+size_t ResourceGovernor::_steps = 0;
+
+/**
+ * Starts the governing of the resources
+ *
+ * @param[in]  timeout  wall-time budget in seconds (0 = unlimited)
+ * @param[in]  memLimit  memory budget in MB (0 = unlimited)
+ * @param[in]  stepLimit  maximal number of safe points (0 = unlimited)
+ * @param[in]  outOfMemory  handler of failed allocations, (re)installed for each run
+ */
+void ResourceGovernor::Start(unsigned int timeout, size_t memLimit, size_t stepLimit, std::new_handler outOfMemory) {
+    _status = GovernorStatus::RUNNING;
+    _interrupted = 0;
+    _steps = 0;
+    _hasDeadline = (timeout != 0);
+    _deadline = ClockType::now() + std::chrono::seconds(timeout);
+    _memLimit = (memLimit > (SIZE_MAX >> 10)) ? SIZE_MAX : (memLimit << 10);
+    _stepLimit = stepLimit;
+    std::set_new_handler(outOfMemory);
+}
+
+/**
+ * Requests the stop of the decision procedure at the next safe point
+ *
+ * @param[in]  status  reason of the stop
+ */
+void ResourceGovernor::RequestStop(GovernorStatus status) {
+    if(_status == GovernorStatus::RUNNING) {
+        _status = status;
+    }
+}
+
+/**
+ * @return  peak resident memory of the process in kB
+ */
+size_t ResourceGovernor::GetPeakMemory() {
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return static_cast<size_t>(usage.ru_maxrss);
+}
+
+/**
+ * Checks all of the budgets and throws GastonResourceExhausted if any of them was exceeded
+ */
+void ResourceGovernor::_CheckBudgets() {
+    if(_interrupted) {
+        RequestStop(GovernorStatus::INTERRUPTED);
+    } else if(_stepLimit != 0 && _steps > _stepLimit) {
+        RequestStop(GovernorStatus::STEP_LIMIT);
+    } else if(_hasDeadline && ClockType::now() > _deadline) {
+        RequestStop(GovernorStatus::TIMEOUT);
+    } else if(_memLimit != 0 && GetPeakMemory() > _memLimit) {
+        RequestStop(GovernorStatus::OUT_OF_MEMORY);
+    }
+    MemoryAccounting::Snapshot();
+    LiveStats::Check();
+
+    if(_status != GovernorStatus::RUNNING) {
+        throw GastonResourceExhausted(_status);
+    }
+}
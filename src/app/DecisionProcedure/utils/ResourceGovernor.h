@@ -0,0 +1,93 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: ResourceGovernor.h
+ *  Description:
+ *      Cooperative governor of wall-time, memory and step budgets of the
+ *      decision procedure. Budgets are checked only at safe points (by
+ *      Poll()), signal handlers merely raise the flag that is handled at
+ *      the next safe point.
+ *****************************************************************************/
+
+#ifndef WSKS_RESOURCEGOVERNOR_H
+#define WSKS_RESOURCEGOVERNOR_H
+
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <new>
+#include "LiveStats.h"
+#include "../environment.hh"
+
+enum class GovernorStatus {RUNNING, TIMEOUT, OUT_OF_MEMORY, STEP_LIMIT, INTERRUPTED};
+
+class GastonResourceExhausted : public std::exception {
+private:
+    GovernorStatus _status;
+public:
+    explicit GastonResourceExhausted(GovernorStatus status) : _status(status) {}
+
+    GovernorStatus GetStatus() const { return _status; }
+    virtual const char* what() const throw() {
+        switch(_status) {
+            case GovernorStatus::TIMEOUT:
+                return "Decision procedure exceeded the time limit";
+            case GovernorStatus::OUT_OF_MEMORY:
+                return "Decision procedure exceeded the memory limit";
+            case GovernorStatus::STEP_LIMIT:
+                return "Decision procedure exceeded the step limit";
+            case GovernorStatus::INTERRUPTED:
+                return "Decision procedure was interrupted by signal";
+            default:
+                return "Decision procedure was stopped";
+        }
+    }
+};
+
+class ResourceGovernor {
+private:
+    using ClockType = std::chrono::steady_clock;
+
+    static volatile std::sig_atomic_t _interrupted;    // < Signal that was raised (0 = none)
+    static GovernorStatus _status;                      // < Sticky status of the governor
+    static ClockType::time_point _deadline;             // < Deadline of the wall-time budget
+    static bool _hasDeadline;
+    static size_t _memLimit;                            // < Memory budget in kB (0 = unlimited)
+    static size_t _stepLimit;                           // < Step budget (0 = unlimited)
+    static size_t _steps;                               // < Number of safe points passed
+
+    static void _CheckBudgets();
+
+public:
+    static void Start(unsigned int timeout, size_t memLimit, size_t stepLimit, std::new_handler outOfMemory);
+    static void Interrupt(int signum) { _interrupted = signum; }
+    static void RequestStop(GovernorStatus status);
+
+    /**
+     * Safe point of the decision procedure, throws GastonResourceExhausted if some of the budgets
+     * was exceeded and prints the requested live statistics. Wall time and memory are checked only once per OPT_GOVERNOR_POLL_PERIOD steps.
+     */
+    static inline void Poll() {
+        ++_steps;
+        if(_interrupted || LiveStats::requested || _status != GovernorStatus::RUNNING || (_stepLimit != 0 && _steps > _stepLimit)
+           || (_steps % OPT_GOVERNOR_POLL_PERIOD) == 0) {
+            _CheckBudgets();
+        }
+    }
+
+    static GovernorStatus GetStatus() { return _status; }
+    static size_t GetSteps() { return _steps; }
+    static size_t GetPeakMemory();
+};
+
+#endif //WSKS_RESOURCEGOVERNOR_H
@@ -18,6 +18,7 @@
 #include "Symbol.h"
 #include <boost/functional/hash.hpp>
 #include "../containers/SymbolicCache.hh"
+#include "MemoryAccounting.h"
 
 extern VarToTrackMap varMap;
 
@@ -56,6 +57,7 @@ namespace Gaston {
 }
 
 size_t ZeroSymbol::instances = 0;
+size_t ZeroSymbol::ids = 0;
 
 // <<< CONSTRUCTORS >>>
 /**
@@ -65,6 +67,7 @@ ZeroSymbol::ZeroSymbol() : _trackMask(varMap.TrackLength() << 1) {
 #   if (MEASURE_SYMBOLS == true)
     ++ZeroSymbol::instances;
 #   endif
+    MemoryAccounting::Allocate(MemoryCategory::SYMBOLS, this->_Footprint());
 }
 
 /**
@@ -77,6 +80,7 @@ ZeroSymbol::ZeroSymbol(BitMask const& track) {
     ++ZeroSymbol::instances;
 #   endif
     this->_trackMask = track;
+    MemoryAccounting::Allocate(MemoryCategory::SYMBOLS, this->_Footprint());
 }
 
 /**
@@ -93,6 +97,7 @@ ZeroSymbol::ZeroSymbol(BitMask const& track, VarType var, VarValue val) {
 #   endif
     this->_trackMask = track;
     this->_SetValueAt(var, ZeroSymbol::charToAsgn(val));
+    MemoryAccounting::Allocate(MemoryCategory::SYMBOLS, this->_Footprint());
 }
 
 ZeroSymbol::ZeroSymbol(ZeroSymbol* src, std::map<unsigned int, unsigned int>* map)  : _trackMask(varMap.TrackLength() << 1) {
@@ -103,9 +108,11 @@ ZeroSymbol::ZeroSymbol(ZeroSymbol* src, std::map<unsigned int, unsigned int>* ma
         unsigned int to = it->second;
         this->_SetValueAt(to, src->GetSymbolAt(from));
     }
+    MemoryAccounting::Allocate(MemoryCategory::SYMBOLS, this->_Footprint());
 }
 
 ZeroSymbol::~ZeroSymbol() {
+    MemoryAccounting::Release(MemoryCategory::SYMBOLS, this->_Footprint());
     this->_trackMask.clear();
 }
 
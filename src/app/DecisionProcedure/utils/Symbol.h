@@ -38,11 +38,14 @@ protected:
     inline void _SetOneAt(VarType var);
     inline void _SetDontCareAt(VarType var);
     inline void _SetValueAt(VarType var, VarValue val);
+    inline size_t _Footprint() const { return sizeof(ZeroSymbol) + this->_trackMask.num_blocks()*sizeof(BitMask::block_type); }
 
 public:
     // <<< STATIC MEMBERS >>>
     static size_t instances;
+    static size_t ids;
     size_t hash = 0;
+    size_t id = ZeroSymbol::ids++;          // < Unique identifier of the symbol, maps it to the slots of symbol tables
 
     // <<< CONSTRUCTORS >>>
     NEVER_INLINE ZeroSymbol();
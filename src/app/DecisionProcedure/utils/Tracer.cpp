@@ -0,0 +1,113 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Tracing of the decision procedure into the Chrome trace-event format
+ *****************************************************************************/
+
+#include "Tracer.h"
+#include <fstream>
+#include <iostream>
+
+bool Tracer::enabled = false;
+TraceEvent* Tracer::_buffer = nullptr;
+size_t Tracer::_capacity = 0;
+size_t Tracer::_head = 0;
+Tracer::ClockType::time_point Tracer::_start = Tracer::ClockType::now();
+std::string Tracer::_filename;
+std::vector<void (*)()> Tracer::_closeHooks;
+
+/**
+ * Opens the tracer, the events are written to @p filename on Close()
+ *
+ * @param[in]  filename  output file for the json trace
+ * @param[in]  capacity  number of events kept in the ring buffer
+ */
+void Tracer::Open(const char* filename, size_t capacity) {
+    _filename = filename;
+    _capacity = capacity;
+    _buffer = new TraceEvent[capacity];
+    _head = 0;
+    enabled = true;
+}
+
+/**
+ * Records the event into the ring buffer, if the buffer is full, the oldest events are overwritten.
+ */
+void Tracer::_Record(const char* name, const char* category, char phase, std::uint64_t ts, std::uint64_t dur,
+                     const void* id, const char* arg0, std::uint64_t val0, const char* arg1, std::uint64_t val1) {
+    size_t slot = (_head++) % _capacity;
+    TraceEvent& event = _buffer[slot];
+    event.name = name;
+    event.category = category;
+    event.phase = phase;
+    event.ts = ts;
+    event.dur = dur;
+    event.id = id;
+    event.argNames[0] = arg0;
+    event.args[0] = val0;
+    event.argNames[1] = arg1;
+    event.args[1] = val1;
+}
+
+/**
+ * Runs the close hooks, writes the recorded events as the Chrome trace-event json and disables the tracer
+ */
+void Tracer::Close() {
+    if(!enabled) {
+        return;
+    }
+    // Hooks may still record the events of the unfinished work
+    for(auto hook : _closeHooks) {
+        hook();
+    }
+    enabled = false;
+
+    std::ofstream os;
+    os.open(_filename);
+    if(!os.is_open()) {
+        std::cerr << "[!] Unable to open trace file '" << _filename << "'\n";
+    } else {
+        size_t head = _head;
+        size_t first = (head > _capacity ? head - _capacity : 0);
+        os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        for(size_t i = first; i < head; ++i) {
+            TraceEvent& event = _buffer[i % _capacity];
+            os << (i == first ? "" : ",\n");
+            os << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category << "\", \"ph\": \"" << event.phase;
+            os << "\", \"pid\": 1, \"tid\": 1, \"ts\": " << event.ts;
+            if(event.phase == 'X') {
+                os << ", \"dur\": " << event.dur;
+            } else if(event.phase == 'i') {
+                os << ", \"s\": \"t\"";
+            } else if(event.id != nullptr) {
+                os << ", \"id\": \"" << event.id << "\"";
+            }
+            if(event.argNames[0] != nullptr) {
+                os << ", \"args\": {\"" << event.argNames[0] << "\": " << event.args[0];
+                if(event.argNames[1] != nullptr) {
+                    os << ", \"" << event.argNames[1] << "\": " << event.args[1];
+                }
+                os << "}";
+            }
+            os << "}";
+        }
+        os << "\n]}\n";
+        if(head > _capacity) {
+            std::cout << "[*] Trace buffer overflowed, " << (head - _capacity) << " oldest events were dropped\n";
+        }
+    }
+
+    delete[] _buffer;
+    _buffer = nullptr;
+}
@@ -0,0 +1,112 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: Tracer.h
+ *  Description:
+ *      Tracing of the timeline of the decision procedure into the Chrome
+ *      trace-event format. Events are stored in the ring buffer (the oldest
+ *      events are overwritten) and written at the end. The tracer is not
+ *      synchronized, it may be used only by the single thread of the
+ *      decision procedure (forked workers do not write their events).
+ *****************************************************************************/
+
+#ifndef WSKS_TRACER_H
+#define WSKS_TRACER_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct TraceEvent {
+    const char* name;                   // < Name of the event (static string)
+    const char* category;               // < Category of the event (static string)
+    char phase;                         // < 'X' = complete, 'i' = instant, 'C' = counter
+    std::uint64_t ts;                   // < Timestamp in us
+    std::uint64_t dur;                  // < Duration in us (for complete events)
+    const void* id;                     // < Identification of the counter track
+    const char* argNames[2];            // < Names of the arguments (or nullptr)
+    std::uint64_t args[2];              // < Values of the arguments
+};
+
+class Tracer {
+private:
+    using ClockType = std::chrono::steady_clock;
+
+    static TraceEvent* _buffer;
+    static size_t _capacity;
+    static size_t _head;                            // < Number of recorded events
+    static ClockType::time_point _start;
+    static std::string _filename;
+    static std::vector<void (*)()> _closeHooks;   // < Called before the events are written
+
+    static void _Record(const char* name, const char* category, char phase, std::uint64_t ts, std::uint64_t dur,
+                        const void* id, const char* arg0, std::uint64_t val0, const char* arg1, std::uint64_t val1);
+
+public:
+    static bool enabled;
+
+    static void Open(const char* filename, size_t capacity);
+    static void Close();
+    static void OnClose(void (*hook)()) { _closeHooks.push_back(hook); }
+
+    /**
+     * @return  time elapsed since the opening of the tracer in us
+     */
+    static std::uint64_t Now() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(ClockType::now() - _start).count();
+    }
+
+    static void Span(const char* name, const char* category, std::uint64_t start, std::uint64_t end,
+                     const char* arg0 = nullptr, std::uint64_t val0 = 0, const char* arg1 = nullptr, std::uint64_t val1 = 0) {
+        if(enabled) {
+            _Record(name, category, 'X', start, (end > start ? end - start : 0), nullptr, arg0, val0, arg1, val1);
+        }
+    }
+
+    static void Complete(const char* name, const char* category, std::uint64_t start,
+                         const char* arg0 = nullptr, std::uint64_t val0 = 0, const char* arg1 = nullptr, std::uint64_t val1 = 0) {
+        if(enabled) {
+            Span(name, category, start, Now(), arg0, val0, arg1, val1);
+        }
+    }
+
+    static void Instant(const char* name, const char* category) {
+        if(enabled) {
+            _Record(name, category, 'i', Now(), 0, nullptr, nullptr, 0, nullptr, 0);
+        }
+    }
+
+    static void Counter(const char* name, const void* id, const char* arg0, std::uint64_t val0,
+                        const char* arg1 = nullptr, std::uint64_t val1 = 0) {
+        if(enabled) {
+            _Record(name, "counter", 'C', Now(), 0, id, arg0, val0, arg1, val1);
+        }
+    }
+
+    /**
+     * Traces the lifetime of the scope as one complete event
+     */
+    class Scope {
+    private:
+        const char* _name;
+        const char* _category;
+        std::uint64_t _start;
+    public:
+        Scope(const char* name, const char* category) : _name(name), _category(category), _start(enabled ? Now() : 0) {}
+        ~Scope() { Tracer::Complete(_name, _category, _start); }
+    };
+};
+
+#endif //WSKS_TRACER_H
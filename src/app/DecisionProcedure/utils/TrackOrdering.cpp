@@ -0,0 +1,225 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Ordering of the tracks
+ *****************************************************************************/
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include "TrackOrdering.h"
+#include "../../Frontend/predlib.h"
+#include "../../Frontend/symboltable.h"
+
+extern PredicateLib predicateLib;
+extern SymbolTable symbolTable;
+
+/**
+ * Collects the interactions and quantifier depths of the variables of @p formula
+ *
+ * @param[in] formula:  preprocessed formula
+ */
+TrackOrdering::TrackOrdering(ASTForm* formula) {
+    assert(formula != nullptr);
+    this->_Walk(formula, 0);
+}
+
+/**
+ * @param[in] form:  walked formula
+ * @param[in] depth:  number of quantifiers above @p form
+ */
+void TrackOrdering::_Walk(ASTForm* form, size_t depth) {
+    IdentList* vl;
+    switch(form->kind) {
+        case aAnd:
+        case aOr:
+        case aImpl:
+        case aBiimpl:
+            this->_Walk(static_cast<ASTForm_ff*>(form)->f1, depth);
+            this->_Walk(static_cast<ASTForm_ff*>(form)->f2, depth);
+            break;
+        case aNot:
+            this->_Walk(static_cast<ASTForm_Not*>(form)->f, depth);
+            break;
+        case aEx0:
+        case aAll0:
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2:
+            vl = (form->kind == aEx0 || form->kind == aAll0) ? static_cast<ASTForm_vf*>(form)->vl :
+                                                               static_cast<ASTForm_uvf*>(form)->vl;
+            for(auto it = vl->begin(); it != vl->end(); ++it) {
+                this->_depths[*it] = std::max(this->_depths[*it], depth + 1);
+            }
+            this->_Walk(static_cast<ASTForm_q*>(form)->f, depth + 1);
+            break;
+        case aCall: {
+            this->_AddAtom(form);
+            // Shared body is walked only once for all of its call sites
+            ASTForm_Call* call = static_cast<ASTForm_Call*>(form);
+            ASTForm* body = predicateLib.lookup(call->n)->sharedAst;
+            if(body != nullptr && this->_walkedPredicates.insert(call->n).second) {
+                this->_Walk(body, depth);
+            }
+            break;
+        }
+        default:
+            this->_AddAtom(form);
+            break;
+    }
+}
+
+/**
+ * Each pair of the free variables of the atom @p form interacts once more
+ */
+void TrackOrdering::_AddAtom(ASTForm* form) {
+    IdentList free, bound;
+    form->freeVars(&free, &bound);
+    for(auto it = free.begin(); it != free.end(); ++it) {
+        for(auto jt = free.begin(); jt != free.end(); ++jt) {
+            if(*it != *jt) {
+                ++this->_interactions[*it][*jt];
+            }
+        }
+    }
+}
+
+size_t TrackOrdering::_Depth(Ident var) {
+    auto it = this->_depths.find(var);
+    return (it == this->_depths.end() ? 0 : it->second);
+}
+
+size_t TrackOrdering::_Degree(Ident var) {
+    auto it = this->_interactions.find(var);
+    return (it == this->_interactions.end() ? 0 : it->second.size());
+}
+
+/**
+ * Reorders the @p vars by the Cuthill-McKee ordering of their interaction graph. Each component is searched from
+ * its outermost least connected variable, neighbours are visited from the strongest interaction, then the outermost
+ * and least connected ones. Variables listed in @p override come first, in the given order.
+ *
+ * @param[in,out] vars:  variables mapped to the tracks
+ * @param[in] override:  comma separated names of the variables, that are ordered by hand
+ */
+void TrackOrdering::Order(IdentList* vars, const char* override) {
+    std::vector<Ident> remaining(vars->begin(), vars->end());
+    std::vector<Ident> order;
+    if(override != nullptr) {
+        this->_Override(order, remaining, override);
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&order](Ident var) {
+            return std::find(order.begin(), order.end(), var) != order.end();
+        }), remaining.end());
+    }
+
+    auto outermost = [this](Ident lhs, Ident rhs) {
+        return std::make_tuple(this->_Depth(lhs), this->_Degree(lhs), lhs) <
+               std::make_tuple(this->_Depth(rhs), this->_Degree(rhs), rhs);
+    };
+    std::set<Ident> unplaced(remaining.begin(), remaining.end());
+    while(!unplaced.empty()) {
+        Ident seed = *std::min_element(unplaced.begin(), unplaced.end(), outermost);
+        std::deque<Ident> queue = {seed};
+        unplaced.erase(seed);
+        while(!queue.empty()) {
+            Ident var = queue.front();
+            queue.pop_front();
+            order.push_back(var);
+
+            std::vector<Ident> neighbours;
+            for(auto& interaction : this->_interactions[var]) {
+                if(unplaced.count(interaction.first)) {
+                    neighbours.push_back(interaction.first);
+                }
+            }
+            auto& weights = this->_interactions[var];
+            std::sort(neighbours.begin(), neighbours.end(), [&weights, &outermost](Ident lhs, Ident rhs) {
+                return weights[lhs] != weights[rhs] ? weights[lhs] > weights[rhs] : outermost(lhs, rhs);
+            });
+            for(Ident neighbour : neighbours) {
+                unplaced.erase(neighbour);
+                queue.push_back(neighbour);
+            }
+        }
+    }
+
+    vars->reset();
+    for(Ident var : order) {
+        vars->push_back(var);
+    }
+}
+
+/**
+ * Collects the variables named in @p override, each name stands for all of the variables of that name
+ *
+ * @param[out] order:  named variables in the given order
+ * @param[in] vars:  variables mapped to the tracks
+ * @param[in] override:  comma separated names of the variables
+ */
+void TrackOrdering::_Override(std::vector<Ident>& order, std::vector<Ident>& vars, const char* override) {
+    std::string names(override);
+    size_t start = 0;
+    while(start <= names.size()) {
+        size_t end = names.find(',', start);
+        if(end == std::string::npos) {
+            end = names.size();
+        }
+        std::string name = names.substr(start, end - start);
+        start = end + 1;
+        if(name.empty()) {
+            continue;
+        }
+
+        bool found = false;
+        for(Ident var : vars) {
+            if(name == symbolTable.lookupSymbol(var) && std::find(order.begin(), order.end(), var) == order.end()) {
+                order.push_back(var);
+                found = true;
+            }
+        }
+        if(!found) {
+            std::cerr << "[!] Variable '" << name << "' of the track order does not occur in the formula\n";
+        }
+    }
+}
+
+/**
+ * @param[in] vars:  ordered variables
+ * @return  the longest distance between tracks of the interacting variables
+ */
+size_t TrackOrdering::Bandwidth(IdentList* vars) {
+    std::map<Ident, size_t> positions;
+    size_t position = 0;
+    for(auto it = vars->begin(); it != vars->end(); ++it) {
+        positions[*it] = position++;
+    }
+
+    size_t bandwidth = 0;
+    for(auto& var : this->_interactions) {
+        auto lhs = positions.find(var.first);
+        if(lhs == positions.end()) {
+            continue;
+        }
+        for(auto& interaction : var.second) {
+            auto rhs = positions.find(interaction.first);
+            if(rhs != positions.end()) {
+                bandwidth = std::max(bandwidth, lhs->second > rhs->second ? lhs->second - rhs->second : rhs->second - lhs->second);
+            }
+        }
+    }
+    return bandwidth;
+}
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: TrackOrdering.h
+ *  Description:
+ *      Ordering of the tracks (and thus of the BDD variables of MONA
+ *      automata). Variables co-occurring in the atoms form the interaction
+ *      graph, whose bandwidth is minimized by the Cuthill-McKee ordering:
+ *      the search starts from the outermost least connected variable and
+ *      visits the strongest interactions first, so the variables of one
+ *      atom end up on the near tracks and the deeply quantified ones low.
+ *****************************************************************************/
+
+#ifndef WSKS_TRACKORDERING_H
+#define WSKS_TRACKORDERING_H
+
+#include <map>
+#include <set>
+#include <vector>
+#include "../../Frontend/ast.h"
+
+class TrackOrdering {
+private:
+    // <<< PRIVATE MEMBERS >>>
+    std::map<Ident, size_t> _depths;                            // < Nesting of the quantifier binding the variable
+    std::map<Ident, std::map<Ident, size_t>> _interactions;     // < Number of the atoms where the variables co-occur
+    std::set<int> _walkedPredicates;
+
+    // <<< PRIVATE METHODS >>>
+    void _Walk(ASTForm*, size_t);
+    void _AddAtom(ASTForm*);
+    size_t _Depth(Ident);
+    size_t _Degree(Ident);
+    void _Override(std::vector<Ident>&, std::vector<Ident>&, const char*);
+
+public:
+    // <<< PUBLIC CONSTRUCTORS >>>
+    explicit TrackOrdering(ASTForm*);
+
+    // <<< PUBLIC API >>>
+    void Order(IdentList*, const char* override = nullptr);
+    size_t Bandwidth(IdentList*);
+};
+
+#endif //WSKS_TRACKORDERING_H
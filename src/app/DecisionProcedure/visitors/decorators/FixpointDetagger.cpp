@@ -2,22 +2,75 @@
 // Created by Raph on 29/01/2016.
 //
 
+#include <cmath>
 #include "FixpointDetagger.h"
 #include "../../environment.hh"
+#include "../../../Frontend/predlib.h"
+
+extern PredicateLib predicateLib;
 
 void FixpointDetagger::visit(ASTForm *form) {
-    if(form->fixpoint_number <= this->_cFixpointThreshold) {
+    if(this->_ToAutomaton(form)) {
         form->tag = 0;
     }
 }
 
+/**
+ * Decides whether @p form is converted to automaton. Unless in adaptive mode, everything under the threshold is.
+ * The adaptive mode predicts the cost of MONA to be exponential in the projections of the subformula (each one
+ * can determinize), times the height of its balanced products. Symbolic construction is predicted to cost the
+ * size of the subformula for each of its fixpoints; shared formulae count for each of their call sites, as their
+ * base automaton is reused by all of them. Converted formula is constructed by MONA as a whole, including its
+ * symbolic subformulae.
+ *
+ * @param[in] form:  decided formula
+ * @return  true if @p form should be converted to automaton
+ */
+bool FixpointDetagger::_ToAutomaton(ASTForm* form) {
+    if(!this->_cAdaptive) {
+        return form->fixpoint_number <= this->_cFixpointThreshold;
+    } else if(form->fixpoint_number == 0) {
+        return true;
+    } else if(form->fixpoint_number > OPT_ADAPTIVE_MAX_FIXPOINTS) {
+        return false;
+    }
+
+    // Shared bodies of predicates are not shuffled and keep their dag height unset
+    size_t productHeight = (form->dag_height > 1 ? form->dag_height : form->height);
+    double monaCost = std::ldexp(static_cast<double>(productHeight), this->_Projections(form));
+    double symbolicCost = static_cast<double>(OPT_ADAPTIVE_FIXPOINT_WEIGHT)*form->size*form->fixpoint_number*this->_cReferences;
+    return monaCost <= symbolicCost;
+}
+
+/**
+ * @return  true if @p form will be constructed by MONA
+ */
+bool FixpointDetagger::_IsBase(ASTForm* form) {
+#   if (OPT_USE_BASE_PROJECTION_AUTOMATA == true)
+    return form->tag == 0 || form->fixpoint_number == 0;
+#   else
+    return form->tag == 0;
+#   endif
+}
+
+/**
+ * @return  number of the variables projected in @p form
+ */
+size_t FixpointDetagger::_Projections(ASTForm* form) {
+    auto it = this->_projections.find(form);
+    return (it == this->_projections.end() ? 0 : it->second);
+}
+
 void FixpointDetagger::visit(ASTForm_ff *form) {
     form->fixpoint_number = std::max(form->f1->fixpoint_number, form->f2->fixpoint_number);
     form->height = std::max(form->f1->height, form->f2->height) + 1;
     form->size = form->f1->size + form->f2->size + 1;
+    if(this->_cAdaptive) {
+        this->_projections[form] = this->_Projections(form->f1) + this->_Projections(form->f2);
+    }
 
 #   if(OPT_EXTRACT_MORE_AUTOMATA == true && OPT_CREATE_QF_AUTOMATON == true && MONA_FAIR_MODE == false)
-    if(form->fixpoint_number <= this->_cFixpointThreshold) {
+    if(this->_ToAutomaton(form)) {
 #   else
     if(form->fixpoint_number == 0) {
         if(form->f1->is_restriction) {
@@ -25,6 +78,9 @@ void FixpointDetagger::visit(ASTForm_ff *form) {
         } else {
             form->tag = 0;
         }
+    } else if(this->_cAdaptive && this->_ToAutomaton(form)) {
+        // Products over fixpoints are decided as well, so the quantifiers above them can be converted
+        form->tag = 0;
     }
 #   endif
 }
@@ -33,6 +89,9 @@ void FixpointDetagger::visit(ASTForm_Not *form) {
     form->fixpoint_number = form->f->fixpoint_number;
     form->height = form->f->height + 1;
     form->size = form->f->size + 1;
+    if(this->_cAdaptive) {
+        this->_projections[form] = this->_Projections(form->f);
+    }
 
     if(form->f->tag == 0)  {
         // Pull the negation in
@@ -45,8 +104,11 @@ void FixpointDetagger::_visitFixpointComputation(FixpointFormula *form) {
     form->fixpoint_number = form->f->fixpoint_number + 1;
     form->height = form->f->height + 1;
     form->size = form->f->size + 1;
+    if(this->_cAdaptive) {
+        this->_projections[form] = this->_Projections(form->f) + form->vl->size();
+    }
 
-    if(form->fixpoint_number <= this->_cFixpointThreshold) {
+    if(this->_ToAutomaton(form)) {
         form->tag = 0;
     }
 }
@@ -65,4 +127,25 @@ void FixpointDetagger::visit(ASTForm_All1 *form) {
 
 void FixpointDetagger::visit(ASTForm_All2 *form) {
     this->_visitFixpointComputation<ASTForm_All2>(form);
-}
\ No newline at end of file
+}
+
+void FixpointDetagger::visit(ASTForm_Call *form) {
+    // Body shared by the call sites was detagged during its own preprocessing
+    ASTForm* body = predicateLib.lookup(form->n)->sharedAst;
+    assert(body != nullptr);
+    form->fixpoint_number = body->fixpoint_number;
+    form->height = body->height + 1;
+    form->size = body->size + 1;
+
+    if(this->_cAdaptive) {
+        // Body was already decided with respect to all of its call sites
+        IdentList free, bound;
+        body->freeVars(&free, &bound);
+        this->_projections[form] = bound.size();
+        if(this->_IsBase(body)) {
+            form->tag = 0;
+        }
+    } else if(form->fixpoint_number <= this->_cFixpointThreshold) {
+        form->tag = 0;
+    }
+}
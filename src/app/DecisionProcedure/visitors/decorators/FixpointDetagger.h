@@ -5,18 +5,26 @@
 #ifndef WSKS_FIXPOINTDETAGGER_H
 #define WSKS_FIXPOINTDETAGGER_H
 
+#include <unordered_map>
 #include "../../../Frontend/ast.h"
 #include "../../../Frontend/ast_visitor.h"
 
 class FixpointDetagger : public VoidVisitor {
 private:
     const size_t _cFixpointThreshold;    // < Everything with less than _cFixpointThreshold fixpoint computations will be converted to automaton
+    const bool _cAdaptive;               // < Threshold is ignored and the cost model decides for each subformula
+    const size_t _cReferences;           // < Number of call sites sharing the detagged formula
+    std::unordered_map<ASTForm*, size_t> _projections;
 
     template<class FixpointFormula>
     void _visitFixpointComputation(FixpointFormula*);
+    bool _ToAutomaton(ASTForm*);
+    bool _IsBase(ASTForm*);
+    size_t _Projections(ASTForm*);
 public:
-    FixpointDetagger(size_t fixpoint_limit = 0) :
-            VoidVisitor(Traverse::PostOrder), _cFixpointThreshold(fixpoint_limit) {}
+    FixpointDetagger(size_t fixpoint_limit = 0, bool adaptive = false, size_t references = 1) :
+            VoidVisitor(Traverse::PostOrder), _cFixpointThreshold(fixpoint_limit), _cAdaptive(adaptive),
+            _cReferences(references) {}
 
     void visit(ASTForm* form);
     void visit(ASTTerm* term) {};
@@ -29,6 +37,7 @@ public:
     void visit(ASTForm_Ex2*);
     void visit(ASTForm_All1*);
     void visit(ASTForm_All2*);
+    void visit(ASTForm_Call*);
 };
 
 
@@ -128,4 +128,8 @@ void OccuringVariableDecorator::visit(ASTForm_True *form) {
     if(form->allVars == nullptr) {
         form->allVars = new IdentList();
     }
-}
\ No newline at end of file
+}
+
+void OccuringVariableDecorator::visit(ASTForm_Call *form) {
+    this->_decorateUnaryNode<ASTForm_Call>(form);
+}
@@ -31,6 +31,7 @@ public:
     virtual void visit(ASTForm_Not* form);
     virtual void visit(ASTForm_True* form);
     virtual void visit(ASTForm_False* form);
+    virtual void visit(ASTForm_Call* form);
 private:
     template<class ASTNode>
     void _decorateUnaryNode(ASTNode*);
@@ -143,4 +143,8 @@ void DotWalker::visit(ASTForm_Less* form) {
 
 void DotWalker::visit(ASTForm_LessEq* form) {
     this->_atomicToDot(form);
-}
\ No newline at end of file
+}
+
+void DotWalker::visit(ASTForm_Call* form) {
+    this->_atomicToDot(form);
+}
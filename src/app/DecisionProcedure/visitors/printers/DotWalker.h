@@ -45,6 +45,7 @@ public:
     void visit(ASTForm_NotEqual2* form);
     void visit(ASTForm_Less* form);
     void visit(ASTForm_LessEq* form);
+    void visit(ASTForm_Call* form);
 
 protected:
     std::ofstream _dotFile;
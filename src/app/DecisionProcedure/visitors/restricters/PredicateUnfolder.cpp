@@ -23,7 +23,41 @@ ASTForm* PredicateUnfolder::_unfoldFormula(PredLibEntry* called, ASTList* realPa
     ASTForm* unfoldedFormula = _unfoldCore(clonnedFormula, formalParams, realParams);
 
     PredicateUnfolder predicateUnfolder;
-    return static_cast<ASTForm*>(unfoldedFormula->accept(predicateUnfolder));
+    unfoldedFormula = static_cast<ASTForm*>(unfoldedFormula->accept(predicateUnfolder));
+    this->sharedPredicates.splice(this->sharedPredicates.end(), predicateUnfolder.sharedPredicates);
+    return unfoldedFormula;
+}
+
+/**
+ * Decides whether the call can be bound to the shared automaton of the predicate, i.e. whether each real parameter
+ * is distinct first-order or second-order variable, that is not used as global variable inside the predicate.
+ * Other calls have to be unfolded, since the substitution changes the structure of the body.
+ *
+ * @param called: called macro
+ * @param realParams: real parameters
+ * @return: true if the call can be kept
+ */
+bool PredicateUnfolder::_isShareable(PredLibEntry* called, ASTList* realParams) {
+    IdentList actuals;
+    Ident actual;
+    IdentList::iterator formal = called->formals->begin();
+    for(ASTList::iterator param = realParams->begin(); param != realParams->end(); ++param, ++formal) {
+        MonaTypeTag type = symbolTable.lookupType(*formal);
+        if(type == Parname1 && (*param)->kind == aVar1) {
+            actual = static_cast<ASTTerm1_Var1*>(*param)->n;
+        } else if(type == Parname2 && (*param)->kind == aVar2) {
+            actual = static_cast<ASTTerm2_Var2*>(*param)->n;
+        } else {
+            // Zero-order parameters, universes and terms are substituted
+            return false;
+        }
+
+        if(actuals.exists(actual) || called->frees->exists(actual)) {
+            return false;
+        }
+        actuals.push_back(actual);
+    }
+    return true;
 }
 
 /**
@@ -32,7 +66,16 @@ ASTForm* PredicateUnfolder::_unfoldFormula(PredLibEntry* called, ASTList* realPa
  * @param[in] form:     traversed Call node
  */
 AST* PredicateUnfolder::visit(ASTForm_Call* form) {
-    ASTForm* unfoldedFormula = _unfoldFormula(predicateLib.lookup(form->n), form->args);
+    PredLibEntry* called = predicateLib.lookup(form->n);
+#   if (OPT_SHARE_PREDICATE_AUTOMATA == true)
+    if(this->_isShareable(called, form->args)) {
+        // Call site is bound to the automaton of the body, that is preprocessed only once
+        this->sharedPredicates.push_back(called);
+        return form;
+    }
+#   endif
+
+    ASTForm* unfoldedFormula = _unfoldFormula(called, form->args);
 
     delete form;
 
@@ -11,6 +11,7 @@
 #include "../../../Frontend/predlib.h"
 #include "../../../Frontend/symboltable.h"
 #include "../../environment.hh"
+#include <list>
 
 // < Symbolic decision procedure functions >
 ASTForm* _unfoldCore(ASTForm* form, IdentList* fParams, ASTList* rParams);
@@ -18,8 +19,11 @@ ASTForm* _unfoldCore(ASTForm* form, IdentList* fParams, ASTList* rParams);
 class PredicateUnfolder : public TransformerVisitor {
 private:
     ASTForm* _unfoldFormula(PredLibEntry* called, ASTList* realParams);
+    bool _isShareable(PredLibEntry* called, ASTList* realParams);
 
 public:
+    std::list<PredLibEntry*> sharedPredicates;   // < Predicates of the kept call sites, their bodies have to be preprocessed
+
     PredicateUnfolder() : TransformerVisitor(Traverse::PostOrder) {}
 
     AST* visit(ASTForm_Call* form);
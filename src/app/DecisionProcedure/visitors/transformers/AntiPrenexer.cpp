@@ -11,6 +11,8 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include "AntiPrenexer.h"
 #include "BooleanUnfolder.h"
 #include "../restricters/NegationUnfolder.h"
@@ -197,6 +199,159 @@ ASTForm* FullAntiPrenexer::nonDistributiveRule(QuantifierClass *qForm, bool only
     }
 }
 
+/*-------------------------------------------------------------------------*
+ | Ex X,Y . f1 /\ f2 /\ f3  ->  f1 /\ (Ex X,Y. f2 /\ f3)                     |
+ |                                     -- if X,Y \notin freeVars(f1)        |
+ *-------------------------------------------------------------------------*/
+
+/**
+ * Schedules the projections of @p qForm over the chain of its @p BinopClass operators (conjunctions for existential
+ * and disjunctions for universal quantifier), similarly to the early quantification in image computation. Operands
+ * are greedily grouped by the variable with the cheapest projection, i.e. with the lowest estimated width of its
+ * fixpoint: number of the projected variables times the state spaces of the grouped operands, which are estimated
+ * to be exponential in their occuring variables. The group is projected by each variable, that does not occur
+ * outside of the group, and replaces the grouped operands in the chain.
+ *
+ * @param[in] qForm:  quantifier over the chain of @p BinopClass
+ * @return  formula with scheduled projections or nullptr if there is nothing to schedule
+ */
+template<class QuantifierClass, class BinopClass>
+ASTForm* FullAntiPrenexer::_scheduleQuantifier(QuantifierClass *qForm) {
+    std::vector<ASTForm*> operands, binops;
+    this->_collectOperands(qForm->f, qForm->f->kind, operands, binops);
+    // Two operands are handled by the non-distributive rule
+    if(operands.size() < 3) {
+        return nullptr;
+    }
+
+    // Variables that do not occur in the chain are dropped as by the other rules
+    std::vector<Ident> projected;
+    for(auto var = qForm->vl->begin(); var != qForm->vl->end(); ++var) {
+        if(std::any_of(operands.begin(), operands.end(), [var](ASTForm* op) { return op->allVars->exists(*var); })) {
+            projected.push_back(*var);
+        }
+    }
+
+    bool scheduled = false;
+    while(!projected.empty()) {
+        std::vector<size_t> bestGroup;
+        std::vector<Ident> bestVars;
+        double bestWidth = 0;
+        for(Ident var : projected) {
+            std::vector<size_t> group;
+            size_t stateSpace = 0;
+            for(size_t i = 0; i < operands.size(); ++i) {
+                if(operands[i]->allVars->exists(var)) {
+                    group.push_back(i);
+                    stateSpace += operands[i]->allVars->size();
+                }
+            }
+            // Variables occuring everywhere stay on top of the chain
+            if(group.size() == operands.size()) {
+                continue;
+            }
+
+            std::vector<Ident> vars;
+            for(Ident other : projected) {
+                bool outside = false;
+                for(size_t i = 0; i < operands.size() && !outside; ++i) {
+                    outside = operands[i]->allVars->exists(other) && std::find(group.begin(), group.end(), i) == group.end();
+                }
+                if(!outside) {
+                    vars.push_back(other);
+                }
+            }
+
+            double width = std::log2(vars.size()) + stateSpace;
+            if(bestGroup.empty() || width < bestWidth || (width == bestWidth && vars.size() > bestVars.size())) {
+                bestGroup = group;
+                bestVars = vars;
+                bestWidth = width;
+            }
+        }
+
+        if(bestGroup.empty()) {
+            break;
+        }
+
+        std::vector<ASTForm*> grouped;
+        for(size_t i : bestGroup) {
+            grouped.push_back(operands[i]);
+        }
+        ASTForm* body = this->_buildChain<BinopClass>(grouped);
+        IdentList* vl = new IdentList();
+        for(Ident var : bestVars) {
+            vl->insert(var);
+            projected.erase(std::find(projected.begin(), projected.end(), var));
+        }
+        ASTForm* projection = new QuantifierClass(nullptr, vl, body, body->pos);
+        projection->allVars = copy(body->allVars);
+
+        for(auto it = bestGroup.rbegin(); it != bestGroup.rend(); ++it) {
+            operands.erase(operands.begin() + *it);
+        }
+        operands.insert(operands.begin() + bestGroup.front(), projection);
+        scheduled = true;
+    }
+
+    if(!scheduled) {
+        return nullptr;
+    }
+
+    for(ASTForm* binop : binops) {
+        binop->detach();
+        delete binop;
+    }
+    for(ASTForm*& operand : operands) {
+        operand = static_cast<ASTForm*>(operand->accept(*this));
+    }
+    ASTForm* chain = this->_buildChain<BinopClass>(operands);
+
+    if(projected.empty()) {
+        qForm->f = nullptr;
+        delete qForm;
+        return chain;
+    } else {
+        qForm->vl->reset();
+        for(Ident var : projected) {
+            qForm->vl->insert(var);
+        }
+        qForm->f = chain;
+        qForm->allVars = copy(chain->allVars);
+        return qForm;
+    }
+}
+
+/**
+ * Joins the @p operands by the right-leaning chain of @p BinopClass, as done by BinaryReorderer
+ */
+template<class BinopClass>
+ASTForm* FullAntiPrenexer::_buildChain(std::vector<ASTForm*>& operands) {
+    assert(!operands.empty());
+    ASTForm* result = operands.back();
+    for(auto it = operands.rbegin() + 1; it != operands.rend(); ++it) {
+        IdentList* allVars = ident_union((*it)->allVars, result->allVars);
+        result = new BinopClass(*it, result, Pos());
+        result->allVars = (allVars == nullptr ? new IdentList() : allVars);
+    }
+    return result;
+}
+
+/**
+ * Collects the operands of the chain of @p kind and its inner nodes
+ */
+void FullAntiPrenexer::_collectOperands(ASTForm* form, ASTKind kind, std::vector<ASTForm*>& operands, std::vector<ASTForm*>& binops) {
+    if(form->kind == kind) {
+        ASTForm_ff* ff = static_cast<ASTForm_ff*>(form);
+        this->_collectOperands(ff->f1, kind, operands, binops);
+        this->_collectOperands(ff->f2, kind, operands, binops);
+        binops.push_back(form);
+    } else {
+        assert(form->allVars != nullptr);
+        operands.push_back(form);
+    }
+}
+
 template<class OuterQuantifier, class InnerQuantifier>
 ASTForm* FullAntiPrenexer::_pushExistentialByOne(OuterQuantifier *form, bool byOne) {
     ASTForm* f = existentialAntiPrenex<InnerQuantifier>(form->f, true);
@@ -351,6 +506,11 @@ ASTForm* FullAntiPrenexer::existentialAntiPrenex(ASTForm *form, bool onlyByOne)
             // Process Or Rule
             return distributiveRule<ExistClass, ASTForm_Or>(exForm, false);
         case aAnd:
+#           if (OPT_SCHEDULE_QUANTIFIERS == true)
+            if((temp = this->_scheduleQuantifier<ExistClass, ASTForm_And>(exForm)) != nullptr) {
+                return temp;
+            }
+#           endif
             // Process And Rule
             return nonDistributiveRule<ExistClass, ASTForm_And>(exForm, false);
         case aImpl:
@@ -395,8 +555,16 @@ ASTForm* FullAntiPrenexer::universalAntiPrenex(ASTForm *form, bool onlyByOne) {
     static_assert(std::is_base_of<ASTForm_q, ForallClass>::value, "ForallClass is not derived from 'ASTForm_q' class");
 
     ForallClass* allForm = static_cast<ForallClass*>(form);
+#   if (OPT_SCHEDULE_QUANTIFIERS == true)
+    ASTForm* temp;
+#   endif
     switch(allForm->f->kind) {
         case aOr:
+#           if (OPT_SCHEDULE_QUANTIFIERS == true)
+            if((temp = this->_scheduleQuantifier<ForallClass, ASTForm_Or>(allForm)) != nullptr) {
+                return temp;
+            }
+#           endif
             // Process Or Rule
             return nonDistributiveRule<ForallClass, ASTForm_Or>(allForm, false);
         case aAnd:
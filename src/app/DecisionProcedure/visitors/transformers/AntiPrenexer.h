@@ -13,6 +13,7 @@
 #ifndef WSKS_ANTIPRENEXER_H
 #define WSKS_ANTIPRENEXER_H
 
+#include <vector>
 #include "../../../Frontend/ast.h"
 #include "../../../Frontend/ast_visitor.h"
 
@@ -43,6 +44,10 @@ public:
  * |All X . f1 \/ f2    ->    f1 \/ (All X. f2)  -- if X \notin freeVars(f1) |
  * |All X . f1 /\ f2    ->    (All X. f1) /\ (All X. f2)\                    |
  * *-------------------------------------------------------------------------*
+ *
+ * With OPT_SCHEDULE_QUANTIFIERS the quantifiers over longer chains of
+ * conjunctions (disjunctions for universal) are scheduled, so the operands
+ * are regrouped and each variable is projected over the cheapest group.
  */
 class FullAntiPrenexer : public AntiPrenexer {
 public:
@@ -78,6 +83,11 @@ private:
     ASTForm* _pushCompatibleExistentialByOne(OuterQuantifier* form, bool byOne = false);
     template<class OuterQuantifier>
     ASTForm* _pushNegationByOne(OuterQuantifier* f, bool byOne);
+    template<class QuantifierClass, class BinopClass>
+    ASTForm* _scheduleQuantifier(QuantifierClass* qForm);
+    template<class BinopClass>
+    ASTForm* _buildChain(std::vector<ASTForm*>& operands);
+    void _collectOperands(ASTForm* form, ASTKind kind, std::vector<ASTForm*>& operands, std::vector<ASTForm*>& binops);
 };
 
 /**
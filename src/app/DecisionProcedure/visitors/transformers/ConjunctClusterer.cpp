@@ -0,0 +1,264 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Clustering of the conjuncts constructed by MONA
+ *****************************************************************************/
+
+#include <algorithm>
+#include "ConjunctClusterer.h"
+#include "../../environment.hh"
+
+/**
+ * Partitions the conjuncts of the chain of conjunctions, that are constructed by MONA, into clusters. Conjunct joins
+ * the cluster with the most shared variables, whose predicted product stays under the budget, or opens the new one.
+ *
+ * @param[in] form:  root of the chain of conjunctions
+ * @return  chain of clusters and symbolic conjuncts
+ */
+AST* ConjunctClusterer::visit(ASTForm_And* form) {
+    if(form->is_cluster_product) {
+        return form;
+    }
+
+    std::vector<ASTForm*> conjuncts;
+    this->_CollectConjuncts(form, conjuncts);
+
+    std::vector<ASTForm*> symbolic;
+    std::vector<Cluster> clusters;
+    for(ASTForm* conjunct : conjuncts) {
+        if(!this->_IsBase(conjunct) || conjunct->is_restriction) {
+            symbolic.push_back(conjunct);
+            continue;
+        }
+
+        VariableSet vars = this->_FreeVars(conjunct);
+        double states = this->_PredictStates(conjunct);
+        Cluster* best = nullptr;
+        size_t bestOverlap = 0;
+        double bestStates = 0;
+        for(Cluster& cluster : clusters) {
+            double product = this->_PredictProduct(cluster.states, cluster.vars, states, vars);
+            if(product > OPT_CLUSTER_STATE_BUDGET) {
+                continue;
+            }
+            size_t overlap = std::count_if(vars.begin(), vars.end(), [&cluster](Ident var) {
+                return cluster.vars.count(var) != 0;
+            });
+            if(best == nullptr || overlap > bestOverlap || (overlap == bestOverlap && product < bestStates)) {
+                best = &cluster;
+                bestOverlap = overlap;
+                bestStates = product;
+            }
+        }
+
+        if(best == nullptr) {
+            clusters.emplace_back();
+            best = &clusters.back();
+            bestStates = states;
+        }
+        best->conjuncts.push_back(conjunct);
+        best->vars.insert(vars.begin(), vars.end());
+        best->states = bestStates;
+    }
+
+    // Single cluster is what the construction does anyway
+    if(clusters.size() < 2) {
+        this->_VisitSymbolicConjuncts(form);
+        return form;
+    }
+
+    std::vector<ASTForm*> operands;
+    for(Cluster& cluster : clusters) {
+        operands.push_back(this->_BuildConjunction(cluster.conjuncts, false));
+    }
+    this->clusters += clusters.size();
+    for(ASTForm* conjunct : symbolic) {
+        operands.push_back(static_cast<ASTForm*>(conjunct->accept(*this)));
+    }
+    ASTForm* result = this->_BuildConjunction(operands, true);
+    result->fixpoints_from_root = form->fixpoints_from_root;
+    return result;
+}
+
+/**
+ * Collects the operands of the chain of conjunctions
+ */
+void ConjunctClusterer::_CollectConjuncts(ASTForm* form, std::vector<ASTForm*>& conjuncts) {
+    if(form->kind == aAnd && !form->is_cluster_product) {
+        ASTForm_And* andForm = static_cast<ASTForm_And*>(form);
+        this->_CollectConjuncts(andForm->f1, conjuncts);
+        this->_CollectConjuncts(andForm->f2, conjuncts);
+    } else {
+        conjuncts.push_back(form);
+    }
+}
+
+/**
+ * Clusters the conjunctions nested in the symbolic conjuncts of the chain, that is kept as it is
+ */
+void ConjunctClusterer::_VisitSymbolicConjuncts(ASTForm_And* form) {
+    for(ASTForm** operand : {&form->f1, &form->f2}) {
+        if((*operand)->kind == aAnd && !(*operand)->is_cluster_product) {
+            this->_VisitSymbolicConjuncts(static_cast<ASTForm_And*>(*operand));
+        } else if(!this->_IsBase(*operand) || (*operand)->is_restriction) {
+            *operand = static_cast<ASTForm*>((*operand)->accept(*this));
+        }
+    }
+}
+
+/**
+ * Joins the @p operands by the right-leaning chain of conjunctions, the tags and measures of the new nodes are
+ * computed the same way the FixpointDetagger does.
+ *
+ * @param[in] operands:  joined operands
+ * @param[in] clusterProduct:  true if the chain joins the clusters (and is thus kept symbolic)
+ * @return  chain of conjunctions
+ */
+ASTForm* ConjunctClusterer::_BuildConjunction(std::vector<ASTForm*>& operands, bool clusterProduct) {
+    assert(!operands.empty());
+    ASTForm* result = operands.back();
+    for(auto it = operands.rbegin() + 1; it != operands.rend(); ++it) {
+        ASTForm_And* conjunction = new ASTForm_And(*it, result, Pos());
+        conjunction->fixpoint_number = std::max((*it)->fixpoint_number, result->fixpoint_number);
+        conjunction->height = std::max((*it)->height, result->height) + 1;
+        conjunction->dag_height = std::max((*it)->dag_height, result->dag_height) + 1;
+        conjunction->size = (*it)->size + result->size + 1;
+        conjunction->tag = (clusterProduct ? 1 : 0);
+        conjunction->is_cluster_product = clusterProduct;
+        result = conjunction;
+    }
+    return result;
+}
+
+/**
+ * @return  true if the @p form will be constructed by MONA
+ */
+bool ConjunctClusterer::_IsBase(ASTForm* form) {
+#   if (OPT_USE_BASE_PROJECTION_AUTOMATA == true)
+    return !form->is_cluster_product && (form->tag == 0 || form->fixpoint_number == 0);
+#   else
+    return form->tag == 0;
+#   endif
+}
+
+ConjunctClusterer::VariableSet ConjunctClusterer::_FreeVars(ASTForm* form) {
+    IdentList free, bound;
+    form->freeVars(&free, &bound);
+    return VariableSet(free.begin(), free.end());
+}
+
+/**
+ * Predicts the number of states of the minimal DFA of @p form. Atoms read each of their variables in the separate
+ * state, negation keeps the states, projection is predicted to double them.
+ *
+ * @param[in] form:  predicted formula
+ * @return  predicted number of states
+ */
+double ConjunctClusterer::_PredictStates(ASTForm* form) {
+    auto cached = this->_predictions.find(form);
+    if(cached != this->_predictions.end()) {
+        return cached->second;
+    }
+
+    double states;
+    switch(form->kind) {
+        case aAnd:
+        case aOr:
+        case aImpl:
+        case aBiimpl: {
+            ASTForm_ff* ff = static_cast<ASTForm_ff*>(form);
+            VariableSet lhsVars = this->_FreeVars(ff->f1);
+            VariableSet rhsVars = this->_FreeVars(ff->f2);
+            states = this->_PredictProduct(this->_PredictStates(ff->f1), lhsVars, this->_PredictStates(ff->f2), rhsVars);
+            break;
+        }
+        case aNot:
+            states = this->_PredictStates(static_cast<ASTForm_Not*>(form)->f);
+            break;
+        case aEx1:
+        case aEx2:
+        case aAll1:
+        case aAll2:
+            states = 2*this->_PredictStates(static_cast<ASTForm_q*>(form)->f);
+            break;
+        case aTrue:
+        case aFalse:
+            states = 1;
+            break;
+        default:
+            states = 2 + this->_FreeVars(form).size();
+            break;
+    }
+    this->_predictions[form] = states;
+    return states;
+}
+
+/**
+ * Predicts the number of states of the product. Product of independent operands multiplies their states, each
+ * shared variable synchronizes the operands and prunes the product.
+ *
+ * @return  predicted number of states of the product
+ */
+double ConjunctClusterer::_PredictProduct(double lhsStates, VariableSet& lhsVars, double rhsStates, VariableSet& rhsVars) {
+    size_t shared = std::count_if(rhsVars.begin(), rhsVars.end(), [&lhsVars](Ident var) {
+        return lhsVars.count(var) != 0;
+    });
+    return std::max(lhsStates*rhsStates / (1 + shared), std::max(lhsStates, rhsStates));
+}
+
+template<class BinopClass>
+AST* ConjunctClusterer::_visitBinary(BinopClass* form) {
+    form->f1 = static_cast<ASTForm*>(form->f1->accept(*this));
+    form->f2 = static_cast<ASTForm*>(form->f2->accept(*this));
+    return form;
+}
+
+template<class QuantifierClass>
+AST* ConjunctClusterer::_visitQuantifier(QuantifierClass* form) {
+    form->f = static_cast<ASTForm*>(form->f->accept(*this));
+    return form;
+}
+
+AST* ConjunctClusterer::visit(ASTForm_Or* form) {
+    return this->_visitBinary<ASTForm_Or>(form);
+}
+
+AST* ConjunctClusterer::visit(ASTForm_Impl* form) {
+    return this->_visitBinary<ASTForm_Impl>(form);
+}
+
+AST* ConjunctClusterer::visit(ASTForm_Biimpl* form) {
+    return this->_visitBinary<ASTForm_Biimpl>(form);
+}
+
+AST* ConjunctClusterer::visit(ASTForm_Not* form) {
+    form->f = static_cast<ASTForm*>(form->f->accept(*this));
+    return form;
+}
+
+AST* ConjunctClusterer::visit(ASTForm_Ex1* form) {
+    return this->_visitQuantifier<ASTForm_Ex1>(form);
+}
+
+AST* ConjunctClusterer::visit(ASTForm_Ex2* form) {
+    return this->_visitQuantifier<ASTForm_Ex2>(form);
+}
+
+AST* ConjunctClusterer::visit(ASTForm_All1* form) {
+    return this->_visitQuantifier<ASTForm_All1>(form);
+}
+
+AST* ConjunctClusterer::visit(ASTForm_All2* form) {
+    return this->_visitQuantifier<ASTForm_All2>(form);
+}
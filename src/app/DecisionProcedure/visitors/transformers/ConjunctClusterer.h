@@ -0,0 +1,75 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: ConjunctClusterer.h
+ *  Description:
+ *      Partitions the conjuncts, that are constructed by MONA, into the
+ *      clusters whose products are predicted to stay under the state budget.
+ *      Each cluster is built as one base automaton and the clusters are
+ *      joined by the symbolic products (marked by is_cluster_product).
+ *      Predictions are cheap: atoms are sized by their variables, products
+ *      by the number of the shared variables of their operands.
+ *
+ *      Has to be run on the tagged and detagged formula.
+ *****************************************************************************/
+
+#ifndef WSKS_CONJUNCTCLUSTERER_H
+#define WSKS_CONJUNCTCLUSTERER_H
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "../../../Frontend/ast.h"
+#include "../../../Frontend/ast_visitor.h"
+
+class ConjunctClusterer : public TransformerVisitor {
+private:
+    using VariableSet = std::set<Ident>;
+
+    struct Cluster {
+        std::vector<ASTForm*> conjuncts;
+        VariableSet vars;
+        double states;                      // < Predicted number of states of the MONA product
+    };
+
+    std::unordered_map<ASTForm*, double> _predictions;
+
+    template<class QuantifierClass>
+    AST* _visitQuantifier(QuantifierClass*);
+    template<class BinopClass>
+    AST* _visitBinary(BinopClass*);
+    void _CollectConjuncts(ASTForm*, std::vector<ASTForm*>&);
+    void _VisitSymbolicConjuncts(ASTForm_And*);
+    ASTForm* _BuildConjunction(std::vector<ASTForm*>&, bool);
+    bool _IsBase(ASTForm*);
+    VariableSet _FreeVars(ASTForm*);
+    double _PredictStates(ASTForm*);
+    double _PredictProduct(double, VariableSet&, double, VariableSet&);
+
+public:
+    size_t clusters = 0;                    // < Number of created clusters
+
+    ConjunctClusterer() : TransformerVisitor(Traverse::CustomOrder) {}
+
+    AST* visit(ASTForm_And*);
+    AST* visit(ASTForm_Or*);
+    AST* visit(ASTForm_Impl*);
+    AST* visit(ASTForm_Biimpl*);
+    AST* visit(ASTForm_Not*);
+    AST* visit(ASTForm_Ex1*);
+    AST* visit(ASTForm_Ex2*);
+    AST* visit(ASTForm_All1*);
+    AST* visit(ASTForm_All2*);
+};
+
+#endif //WSKS_CONJUNCTCLUSTERER_H
@@ -27,6 +27,7 @@
 #include "predlib.h"
 #include "lib.h"
 #include "../DecisionProcedure/containers/VarToTrackMap.hh"
+#include "../DecisionProcedure/utils/MemoryAccounting.h"
 
 using std::cout;
 
@@ -40,6 +41,16 @@ extern int numTypes;
 
 std::vector<Ident> AST::temporalMapping;
 
+void* AST::operator new(size_t size) {
+  MemoryAccounting::Allocate(MemoryCategory::AST_NODES, size);
+  return ::operator new(size);
+}
+
+void AST::operator delete(void* ptr, size_t size) {
+  MemoryAccounting::Release(MemoryCategory::AST_NODES, size);
+  ::operator delete(ptr);
+}
+
 //////////  Restriction ///////////////////////////////////////////////////////
 
 static IdentList restrVars; // variables occuring in current restriction
@@ -2184,6 +2195,30 @@ bool ASTTerm2_Set::StructuralCompare(AST* form) {
     }
 }
 
+bool ASTForm_Call::StructuralCompare(AST* form) {
+    assert(form != nullptr);
+    if(this->kind != form->kind || this->n != static_cast<ASTForm_Call*>(form)->n) {
+        return false;
+    } else {
+        ASTForm_Call* call = static_cast<ASTForm_Call*>(form);
+        for(auto it = this->args->begin(), tit = call->args->begin(); it != this->args->end(); ++it, ++tit) {
+            if(!(*it)->StructuralCompare(*tit)) {
+                return false;
+            }
+        }
+        // Global variables of the predicate are the same for both of the calls
+        IdentList* globals = predicateLib.lookup(this->n)->frees;
+        for(auto it = globals->begin(); it != globals->end(); ++it) {
+            Ident mapped = AST::temporalMapping[*it];
+            if(mapped && (mapped - 1) != *it) {
+                return false;
+            }
+            AST::temporalMapping[*it] = *it + 1;
+        }
+        return true;
+    }
+}
+
 // Remapping
 void ASTTerm1_n::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
     assert(this->kind == form->kind);
@@ -2310,4 +2345,59 @@ void ASTForm_Not::ConstructMapping(AST* form, std::map<unsigned int, unsigned in
 
 void ASTTerm2_Empty::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
     assert(this->kind == form->kind);
-}
\ No newline at end of file
+}
+
+/**
+ * Returns the variable passed as the real parameter of the call
+ */
+static Ident call_argument(AST* arg) {
+    if(arg->kind == aVar1) {
+        return static_cast<ASTTerm1_Var1*>(arg)->n;
+    } else {
+        assert(arg->kind == aVar2);
+        return static_cast<ASTTerm2_Var2*>(arg)->n;
+    }
+}
+
+/**
+ * Constructs the mapping of the call site either to the structurally similar call of the same predicate, or to the
+ * formula of the automaton of the shared body. In the latter case the real parameters are mapped through the formal
+ * parameters of the body.
+ */
+void ASTForm_Call::ConstructMapping(AST* form, std::map<unsigned int, unsigned int>& map) {
+    PredLibEntry* called = predicateLib.lookup(this->n);
+    if(form->kind == aCall && static_cast<ASTForm_Call*>(form)->n == this->n) {
+        ASTForm_Call* call = static_cast<ASTForm_Call*>(form);
+        for(auto it = this->args->begin(), tit = call->args->begin(); it != this->args->end(); ++it, ++tit) {
+            (*it)->ConstructMapping(*tit, map);
+        }
+        for(auto it = called->frees->begin(); it != called->frees->end(); ++it) {
+            map[varMap[*it]] = varMap[*it];
+        }
+        return;
+    }
+
+    assert(called->sharedAst != nullptr);
+    std::map<unsigned int, unsigned int> bodyMap;
+    bool isBody = (form == called->sharedAst);
+    if(!isBody) {
+        // Automaton was found in DAG for some formula structurally similar to body
+        called->sharedAst->ConstructMapping(form, bodyMap);
+    }
+
+    IdentList::iterator formal = called->formals->begin();
+    for(auto it = this->args->begin(); it != this->args->end(); ++it, ++formal) {
+        if(isBody) {
+            map[varMap[call_argument(*it)]] = varMap[*formal];
+        } else if(bodyMap.find(varMap[*formal]) != bodyMap.end()) {
+            map[varMap[call_argument(*it)]] = bodyMap[varMap[*formal]];
+        }
+    }
+    for(auto it = called->frees->begin(); it != called->frees->end(); ++it) {
+        if(isBody) {
+            map[varMap[*it]] = varMap[*it];
+        } else if(bodyMap.find(varMap[*it]) != bodyMap.end()) {
+            map[varMap[*it]] = bodyMap[varMap[*it]];
+        }
+    }
+}
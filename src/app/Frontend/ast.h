@@ -114,6 +114,10 @@ public:
 	  }
   };
 
+  // allocation of nodes is accounted to the memory accounting of the decision procedure
+  static void* operator new(size_t);
+  static void operator delete(void*, size_t);
+
   virtual AST* unfoldMacro(IdentList*, ASTList*) { return this;};
   virtual void freeVars(IdentList*, IdentList*) {};
   virtual void dump() {};
@@ -132,6 +136,7 @@ public:
 	bool is_restriction = false;
 	bool under_complement = false;
 	bool epsilon_in = false;
+	bool is_cluster_product = false; // conjunction of clusters kept symbolic (by ConjunctClusterer)
 	static std::vector<Ident> temporalMapping;
   ASTOrder order;
   ASTKind kind;
@@ -905,6 +910,7 @@ public:
 	virtual std::string ToString(bool no_utf = false);
 
 protected:
+  friend class FormulaBundle;
   ASTTerm1 *t1;
   ASTTerm1 *t2;
 };
@@ -921,6 +927,7 @@ public:
 	virtual std::string ToString(bool no_utf = false);
 
 protected:
+  friend class FormulaBundle;
   int value;
 };
 
@@ -1477,6 +1484,9 @@ public:
 	void detach() {this->args = nullptr; }
   ASTForm* clone() { return new ASTForm_Call(this->n, this->args, this->pos); }
   ASTForm* unfoldMacro(IdentList*, ASTList*);
+	SymbolicAutomaton* toSymbolicAutomaton(bool doComplement);
+	virtual void ConstructMapping(AST*, std::map<unsigned int, unsigned int>&);
+	virtual bool StructuralCompare(AST*);
 
   ASTList *args;
   int n;
@@ -103,19 +103,31 @@ VarCode::DFATranslate()
     invariant(!code->mark);
     if (options.intermediate)
       code->show();
+    // Nodes of the persistent table keep their children, so the equal subcodes of
+    // the later translations are found in the table together with their DFAs
+    if (codeTable->persistent)
+      code->keep = true;
     code->makeDFA();
     code->mark = true;
     invariant(code->dfa);
     codeTable->print_progress();
     // Add aggregation of mona states
     Workshops::TermWorkshop::monaAutomataStates += code->dfa->ns;
+    if (codeTable->persistent)
+      codeTable->retain(code);
   }
+  else if (codeTable->persistent)
+    codeTable->reused++;
 
   DFA *a = code->dfa;
   if (code->refs > 1)
     a = st_dfa_copy(a);
-  else
+  else {
     code->dfa = NULL;
+    // Kept parents can ask for the DFA again
+    if (code->keep)
+      code->mark = false;
+  }
   st_dfa_replace_indices(a, vars, &code->vars); 
   return a;
 }
@@ -404,7 +416,7 @@ Code_c::equiv(Code &c)
 unsigned 
 Code_c::hash() 
 {
-  return kind + ((long) vc.code)*128;
+  return hash_combine(kind, (unsigned long) vc.code);
 }
 
 ////////// Code_cc ////////////////////////////////////////////////////////////
@@ -442,7 +454,8 @@ Code_cc::equiv(Code &c)
 unsigned 
 Code_cc::hash() 
 {
-  return kind*2 + ((long) vc1.code)*5 + ((long) vc2.code)*7;
+  return hash_combine(hash_combine(kind, (unsigned long) vc1.code),
+		      (unsigned long) vc2.code);
 }
 
 void 
@@ -451,15 +464,15 @@ Code_cc::makeDFA()
   /* #warning NEW: heuristic choice through DAG - 1-15% lower max-aut. */
   if (vc1.code->refs==1 || (vc2.code->refs>1 && vc1.code->depth<=vc2.code->depth)) {
     a1 = vc1.DFATranslate();
-    vc1.remove();
+    consume(vc1);
     a2 = vc2.DFATranslate();
-    vc2.remove();
+    consume(vc2);
   }
   else {
     a2 = vc2.DFATranslate();
-    vc2.remove();
+    consume(vc2);
     a1 = vc1.DFATranslate();
-    vc1.remove();
+    consume(vc1);
   }
 }
 
@@ -886,7 +899,7 @@ void
 Code_Restrict::makeDFA()
 {
   dfa = st_dfa_minimization(st_dfa_restrict(vc.DFATranslate(), pos));
-  vc.remove();
+  consume(vc);
 }
 
 void 
@@ -930,7 +943,7 @@ Code_Project::makeDFA()
   dfa = st_dfa_minimization(st_dfa_project
 			    (vc.DFATranslate(), 
 			     var, pos));
-  vc.remove();
+  consume(vc);
 }
 
 void 
@@ -948,7 +961,7 @@ void
 Code_Negate::makeDFA()
 {
   dfa = st_dfa_negation(vc.DFATranslate(), pos);
-  vc.remove();
+  consume(vc);
 }
 
 void 
@@ -964,7 +977,7 @@ void
 Code_Prefix::makeDFA()
 {
   dfa = st_dfa_minimization(st_dfa_prefix(vc.DFATranslate(), pos));
-  vc.remove();
+  consume(vc);
 }
 
 ////////// Code_And ///////////////////////////////////////////////////////////
@@ -1152,7 +1165,7 @@ Code_PredCall::makeDFA()
       cout << "-- Leaving predicate '" << symbolTable.lookupSymbol(name)
 	   << "' (states: " << dfa->ns << ") --\n";
   }
-  vc.remove();
+  consume(vc);
 }
 
 void 
@@ -1375,7 +1388,7 @@ Code_Export::makeDFA()
     error("Unable to write file");
   dfaFree(dfa2);
   
-  vc.remove();
+  consume(vc);
 }
 
 void 
@@ -36,6 +36,25 @@
 class VoidCodeVisitor;
 class TransformerCodeVisitor;
 
+////////// Hashing //////////////////////////////////////////////////////////
+
+// mixes the bits of hash value, so also its low bits depend on all of the
+// bits of the key (finalizer of MurmurHash3); tables index by the low bits
+inline unsigned long hash_mix(unsigned long h)
+{
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdUL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53UL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline unsigned long hash_combine(unsigned long seed, unsigned long value)
+{
+  return seed ^ (hash_mix(value) + 0x9e3779b97f4a7c15UL + (seed << 6) + (seed >> 2));
+}
+
 ////////// StateSpaces ////////////////////////////////////////////////////////
 
 SSSet stateSpaces(IdentList *univs); // find state spaces for univs
@@ -120,7 +139,7 @@ class Code {
 public:
   Code(CodeKind knd, Pos p) :
     kind(knd), refs(1), pos(p), mark(0), eqlist(NULL), dfa(NULL), gta(NULL),
-    conj(NULL), restrconj(NULL), depth(0)/**, conjhash(0)**/ {}
+    conj(NULL), restrconj(NULL), depth(0), keep(false)/**, conjhash(0)**/ {}
   virtual ~Code() {}
 
   DAG_VISITABLE();
@@ -138,6 +157,9 @@ public:
   // remove one reference to this node, if last then call recursively
   void remove();
 
+  // release the child, whose DFA was consumed, unless the children are kept
+  void consume(VarCode &c) {if (!keep) c.remove();}
+
   // dump node/subtree contents
   virtual void viz(); // graphviz format
   virtual void dump(bool rec) = 0; // dump recursively/non-recursively
@@ -174,6 +196,7 @@ public:
   VarCodeList *conj;       // conjuncts (used during red.)
   VarCodeList *restrconj;  // restricted conjuncts (used during red.)
   int        depth;        // max number of steps to leaf
+  bool       keep;         // children are kept after makeDFA, so the DFA can be made again
 /**
   unsigned   conjhash;     // hashing of conj and restrconj (used during red.)
 **/
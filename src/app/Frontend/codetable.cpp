@@ -26,6 +26,7 @@
 #include "codetable.h"
 #include "env.h"
 #include "config.h"
+#include "../DecisionProcedure/utils/MemoryAccounting.h"
 
 extern "C" {
 #include "mem.h"
@@ -38,7 +39,7 @@ extern Options options;
 VarCode
 CodeTable::insert(Code *c)
 {
-  unsigned hash = c->hash() % CODE_TABLE_SIZE;
+  unsigned hash = bucket(*c);
   
   for (Deque<Code*>::iterator i = table[hash].begin(); 
        i != table[hash].end(); i++) 
@@ -51,8 +52,13 @@ CodeTable::insert(Code *c)
       return vc;
     }
 
+  if (entries >= tableSize * CODE_TABLE_LOAD) {
+    grow();
+    hash = bucket(*c);
+  }
   table[hash].push_back(c);
   c->bucket = hash;
+  entries++;
 
   // update statistics
   stat_misses++;
@@ -78,7 +84,7 @@ CodeTable::insert(Code *c)
 bool
 CodeTable::exists(Code &c)
 { 
-  unsigned hash = c.hash() % CODE_TABLE_SIZE;
+  unsigned hash = bucket(c);
   
   for (Deque<Code*>::iterator i = table[hash].begin(); 
        i != table[hash].end(); i++)
@@ -90,7 +96,7 @@ CodeTable::exists(Code &c)
 Code*
 CodeTable::findEquiv(Code *c)
 {
-  unsigned hash = c->hash() % CODE_TABLE_SIZE;
+  unsigned hash = bucket(*c);
   
   for (Deque<Code*>::iterator i = table[hash].begin(); 
        i != table[hash].end(); i++)
@@ -113,6 +119,7 @@ CodeTable::remove(Code *c)
 	table[b].set(j, table[b].pop_back());
 
       // update statistics
+      entries--;
       nodes--;
       switch (c->kind) {
       case cProject:
@@ -134,6 +141,55 @@ CodeTable::remove(Code *c)
   invariant(false);
 }
 
+static unsigned long
+dfaBytes(DFA *a) // estimated footprint of the DFA
+{
+  return a->ns*(sizeof(bdd_handle) + sizeof(int)) 
+    + bdd_size(a->bddm)*sizeof(bdd_record);
+}
+
+void
+CodeTable::retain(Code *c)
+{ // keep the node with its DFA for later translations, drop the oldest ones over the limit
+  unsigned long bytes = dfaBytes(c->dfa);
+  if (bytes > retainLimit)
+    return;
+  while (retainedBytes + bytes > retainLimit) {
+    Code *old = retained.pop_front();
+    unsigned long oldBytes = dfaBytes(old->dfa);
+    retainedBytes -= oldBytes;
+    MemoryAccounting::Release(MemoryCategory::MONA_DFA, oldBytes);
+    if (old->refs > 1) {
+      // node is still kept by its parents, its DFA is made again on demand
+      dfaFree(old->dfa);
+      old->dfa = NULL;
+      old->mark = false;
+    }
+    old->remove();
+  }
+  c->refs++;
+  retained.push_back(c);
+  retainedBytes += bytes;
+  MemoryAccounting::Allocate(MemoryCategory::MONA_DFA, bytes);
+}
+
+void
+CodeTable::grow() // doubles the buckets, nodes keep their order in chains
+{
+  unsigned oldSize = tableSize;
+  Deque<Code*> *oldTable = table;
+
+  tableSize *= 2;
+  table = new Deque<Code*>[tableSize];
+  for (unsigned b = 0; b < oldSize; b++)
+    for (Deque<Code*>::iterator i = oldTable[b].begin(); 
+	 i != oldTable[b].end(); i++) {
+      (*i)->bucket = bucket(**i);
+      table[(*i)->bucket].push_back(*i);
+    }
+  delete[] oldTable;
+}
+
 void
 CodeTable::print_statistics()
 {
@@ -165,7 +221,7 @@ CodeTable::print_sizes()
 {
   unsigned i, j;
   cout << "\nDAG hash table bucket sizes:\n";
-  for (i = 0; i < CODE_TABLE_SIZE; i++) 
+  for (i = 0; i < tableSize; i++) 
     if (table[i].size() > 0) {
       cout << i << ": ";
       for (j = 0; j < table[i].size(); j++)
@@ -174,6 +230,21 @@ CodeTable::print_sizes()
     }
 }
 
+void
+CodeTable::print_bucket_statistics()
+{
+  unsigned used = 0, longest = 0;
+  for (unsigned i = 0; i < tableSize; i++) 
+    if (table[i].size() > 0) {
+      used++;
+      if (table[i].size() > longest)
+	longest = table[i].size();
+    }
+  cout << "DAG hash table: " << tableSize << " buckets, " 
+       << used << " used, longest chain: " << longest
+       << ", average chain: " << (used ? (double) entries / used : 0) << "\n";
+}
+
 extern CodeTable *codeTable;
 
 void
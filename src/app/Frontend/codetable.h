@@ -23,7 +23,8 @@
 
 #include "code.h"
 
-#define CODE_TABLE_SIZE 1019
+#define CODE_TABLE_SIZE 1024 // initial number of buckets, power of two
+#define CODE_TABLE_LOAD 2    // average chain length that doubles the buckets
 #define CONJ_TABLE_SIZE 117
 
 /**
@@ -39,7 +40,9 @@ public:
 **/
 
 class CodeTable {
-  Deque<Code*> table[CODE_TABLE_SIZE];
+  Deque<Code*> *table;                           // grows with the load
+  unsigned     tableSize;                        // number of buckets
+  unsigned     entries;                          // number of nodes in buckets
   Deque<SubstCopy> sclist;                       // used during reduction
 /**
   DequeGC<ConjNode*> conjtable[CONJ_TABLE_SIZE]; // used during reduction
@@ -48,16 +51,23 @@ class CodeTable {
 public:
   CodeTable() 
   {stat_hits = stat_misses = nodes = makes = prev
-     = red_proj = red_prod = red_other = num_prod = num_proj = num_other = 0;}
+     = red_proj = red_prod = red_other = num_prod = num_proj = num_other = 0;
+   persistent = false; retainLimit = retainedBytes = 0; reused = 0;
+   tableSize = CODE_TABLE_SIZE; entries = 0;
+   table = new Deque<Code*>[tableSize];}
+  ~CodeTable() 
+  {delete[] table;}
 
   VarCode insert(Code*); 
   bool    exists(Code&);
   Code   *findEquiv(Code*);
   void    remove(Code*);
+  void    retain(Code*);
   void    print_statistics();
   void    print_statistics2();
   void    print_reduction_statistics();
   void    print_sizes();
+  void    print_bucket_statistics();
   void    init_print_progress();
   void    begin();
   void    update();
@@ -72,12 +82,25 @@ public:
   void      conjInsert(ConjNode *n);
 **/
 
+private:
+  unsigned bucket(Code &c) 
+  {return hash_mix(c.hash()) & (tableSize - 1);}
+  void     grow();
+
+public:
+
   int stat_hits, stat_misses, nodes, total_nodes;
 
   int red_prod, red_proj, red_other; // number of reductions
   int num_prod, num_proj, num_other; // number of operations
 
   int makes, prev; // number of automata constructed
+
+  bool persistent; // table survives between translations, DFAs of nodes are kept
+  unsigned long retainLimit;   // maximal size of the kept DFAs (in bytes)
+  unsigned long retainedBytes; // size of the kept DFAs (in bytes)
+  Deque<Code*> retained;       // nodes with kept DFAs, the oldest first
+  int reused;                  // number of DFAs reused instead of translated
 };
 
 #endif
@@ -62,8 +62,24 @@ public:
     serializeMona(false),
     fixLimit(0),
     inverseFixLimit(-1),
+    adaptiveFixLimit(false),
+    trackOrder(nullptr),
     dryRun(false),
-    verifyModels(false) {}
+    verifyModels(false),
+    timeout(0),
+    memLimit(0),
+    stepLimit(0),
+    profile(false),
+    profileFile(nullptr),
+    traceFile(nullptr),
+    memStats(false),
+    memSnapshots(nullptr),
+    decideOnly(false),
+    replayWitnesses(false),
+    incremental(false),
+    compileBundle(false),
+    naryWorkers(0),
+    bestFirst(false) {}
 
 
   bool useMonaDFA;
@@ -100,8 +116,24 @@ public:
   bool serializeMona;
   int fixLimit;
   int inverseFixLimit;
+  bool adaptiveFixLimit;
+  const char* trackOrder;
   bool dryRun;
   bool verifyModels;
+  unsigned int timeout;
+  unsigned long memLimit;
+  unsigned long stepLimit;
+  bool profile;
+  const char* profileFile;
+  const char* traceFile;
+  bool memStats;
+  const char* memSnapshots;
+  bool decideOnly;
+  bool replayWitnesses;
+  bool incremental;
+  bool compileBundle;
+  unsigned long naryWorkers;
+  bool bestFirst;
 };
 
 #endif
@@ -321,7 +321,18 @@ ASTForm_Call::freeVars(IdentList *free, IdentList *bound)
       (*i)->freeVars(free, bound);
 
   PredLibEntry *p = predicateLib.lookup(n);
-  bound->insert(p->bound);
+  if (p->sharedAst) {
+    // formals and variables of the shared body occupy their own tracks
+    IdentList sharedFree, sharedBound;
+    p->sharedAst->freeVars(&sharedFree, &sharedBound);
+    for (IdentList::iterator j = sharedFree.begin(); j != sharedFree.end(); j++)
+      if (!p->formals->exists(*j))
+	free->insert(*j);
+    bound->insert(p->formals);
+    bound->insert(&sharedBound);
+  }
+  else
+    bound->insert(p->bound);
   free->insert(p->frees);
 }
 
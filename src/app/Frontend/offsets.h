@@ -29,6 +29,7 @@ public:
   void insert();
   void reorder();
   int off(unsigned int id) {assert(id<=max_offset); return offsetMap.get(id);}
+  void set(unsigned int id, int off) {assert(id<max_offset); offsetMap.set(id, off);}
   int maxOffset() {return max_offset;};
 
 protected:
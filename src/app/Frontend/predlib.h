@@ -32,7 +32,7 @@ public:
   PredLibEntry(IdentList *eFormals, IdentList *eFrees, IdentList *eBound,
 	       ASTForm *eFormula, bool eIsMacro, int eName, char *eSource) :
     formals(eFormals), frees(eFrees), bound(eBound), ast(eFormula),
-    isMacro(eIsMacro), name(eName), source(eSource) {}
+    isMacro(eIsMacro), name(eName), source(eSource), sharedAst(NULL) {}
   ~PredLibEntry() 
   {delete formals; delete frees; delete bound;
   //delete ast;
@@ -45,6 +45,7 @@ public:
   bool       isMacro;
   Ident      name;
   char      *source;
+  ASTForm   *sharedAst; // preprocessed body shared by the call sites
 };
 
 enum TestResult {
@@ -32,16 +32,20 @@ extern void TypeError(String, Pos &);
 Ident
 SymbolTable::insert(Entry *e)
 {
+  if (noDeclarations >= size * SYMBOL_TABLE_LOAD)
+    grow();
   declarationTable[hash(e->string)].push_back(e);
+  noDeclarations++;
   identMap.push_back(e);
   offsets.insert();
   return noIdents++;
 }
 
 void
-SymbolTable::remove(int idx) // must be at end of Deque
+SymbolTable::remove(Ident id) // must be at end of Deque
 {
-  declarationTable[idx].pop_back();
+  declarationTable[hash(identMap.get(id)->string)].pop_back();
+  noDeclarations--;
   // don't delete and remove from indentMap since the entry
   // might still be in use
 }
@@ -76,12 +80,73 @@ SymbolTable::check(Name *name)
 int
 SymbolTable::hash(char *s) 
 {
-  return (long) s % size;
+  return hash_mix((unsigned long) s) & (size - 1);
+}
+
+int
+SymbolTable::hashString(char *s)
+{
+  unsigned long h = 0;
+  while (*s)
+    h = h*31 + *s++;
+  return hash_mix(h) & (size - 1);
+}
+
+// doubles the buckets; entries of the bucket are split between two buckets
+// and keep their order, so the local declarations are still on top
+void
+SymbolTable::grow()
+{
+  unsigned oldSize = size;
+  Deque<Entry*> *oldDeclarations = declarationTable;
+  Deque<char*> *oldSymbols = symbols;
+
+  size *= 2;
+  declarationTable = new Deque<Entry*>[size];
+  symbols = new Deque<char*>[size];
+  for (unsigned i = 0; i < oldSize; i++) {
+    Deque<Entry*>::iterator e;
+    for (e = oldDeclarations[i].begin(); e != oldDeclarations[i].end(); e++)
+      declarationTable[hash((*e)->string)].push_back(*e);
+    Deque<char*>::iterator s;
+    for (s = oldSymbols[i].begin(); s != oldSymbols[i].end(); s++)
+      symbols[hashString(*s)].push_back(*s);
+  }
+  delete[] oldDeclarations;
+  delete[] oldSymbols;
+}
+
+void
+SymbolTable::print_bucket_statistics()
+{
+  unsigned usedDecls = 0, longestDecl = 0, usedSymbols = 0, longestSymbol = 0;
+  for (unsigned i = 0; i < size; i++) {
+    if (declarationTable[i].size() > 0) {
+      usedDecls++;
+      if (declarationTable[i].size() > longestDecl)
+	longestDecl = declarationTable[i].size();
+    }
+    if (symbols[i].size() > 0) {
+      usedSymbols++;
+      if (symbols[i].size() > longestSymbol)
+	longestSymbol = symbols[i].size();
+    }
+  }
+  cout << "Symbol table: " << size << " buckets\n"
+       << "  declarations: " << usedDecls << " used, longest chain: " 
+       << longestDecl << ", average chain: " 
+       << (usedDecls ? (double) noDeclarations / usedDecls : 0) << "\n"
+       << "  symbols: " << usedSymbols << " used, longest chain: " 
+       << longestSymbol << ", average chain: " 
+       << (usedSymbols ? (double) noSymbols / usedSymbols : 0) << "\n";
 }
 
 SymbolTable::SymbolTable(int s)
 {
-  size = s;
+  for (size = 1; size < (unsigned) s; size *= 2)
+    ;
+  noSymbols = 0;
+  noDeclarations = 0;
   noIdents = 0;
   defaultRestriction1 = NULL;
   defaultRestriction2 = NULL;
@@ -126,11 +191,9 @@ void SymbolTable::cleanUp() {
 char *
 SymbolTable::insertString(char *str)
 {
-  char *t = str;
-  unsigned idx = 0;
-  while (*t)
-    idx = (idx << 1) + *t++;
-  idx = idx % size;
+  if (noSymbols >= size * SYMBOL_TABLE_LOAD)
+    grow();
+  unsigned idx = hashString(str);
 
   char **s;
   for (s = symbols[idx].begin(); s != symbols[idx].end(); s++)
@@ -140,6 +203,7 @@ SymbolTable::insertString(char *str)
     } 
 
   symbols[idx].push_back(str); // string never used before
+  noSymbols++;
   return str; 
 }
 
@@ -156,7 +220,7 @@ SymbolTable::insertVar(Name *name, MonaTypeTag type,
 		       IdentList *univs, bool local, bool implicit)
 {
   if (local)
-    localStack.push_back(hash(name->str));
+    localStack.push_back(noIdents);
   else
     check(name);
   return insert(new VarEntry(name->str, type, noIdents, univs, implicit));
@@ -237,6 +301,32 @@ SymbolTable::insertFresh(MonaTypeTag type, IdentList *univs, bool implicit)
   return insertVar(&dummy, type, univs, false, implicit);
 }
 
+// restores the identifier of precompiled formula bundle in order of the
+// declarations, without the checks of redeclaration; only the variables
+// keep their declarations, the rest is restored by name and type
+Ident
+SymbolTable::restoreEntry(char *name, MonaTypeTag type, IdentList *univs,
+			  bool implicit)
+{
+  if (name)
+    name = insertString(name);
+  switch (type) {
+  case Varname0:
+  case Varname1:
+  case Varname2:
+  case VarnameTree:
+  case Parname0:
+  case Parname1:
+  case Parname2:
+  case ParnameU:
+    return insert(new VarEntry(name, type, noIdents, univs, implicit));
+  case Predname:
+    return insert(new PredEntry(name, noIdents));
+  default:
+    return insert(new Entry(name, type, noIdents));
+  }
+}
+
 void 
 SymbolTable::openLocal()
 {
@@ -26,6 +26,8 @@
 #include "printline.h"
 #include "ident.h"
 
+#define SYMBOL_TABLE_LOAD 2 // average chain length that doubles the buckets
+
 class Name {
 public:
   Name() {} // dummy
@@ -121,19 +123,23 @@ class SymbolTable {
   };
 
   Ident  insert(Entry*);
-  void   remove(int idx); // must be last-in-first-out order
+  void   remove(Ident); // must be last-in-first-out order
   Entry &lookup(Name*);
   void   check(Name*);
   int    hash(char*);
+  int    hashString(char*);
+  void   grow();
 
   Deque<char*>  *symbols;          // hashtable of symbols
   Deque<Entry*> *declarationTable; // hashtable String->Entry
-  Deque<int>     localStack;       // stack of hashtable indexes (-1 sentinel) 
+  Deque<int>     localStack;       // stack of local Idents (-1 sentinel) 
   Deque<Entry*>  identMap;         // map Ident->Entry
   IdentList      allUnivIds;       // all universe Idents, sorted
   IdentList      allRealUnivIds;   // allUnivIds except dummy
   IdentList      statespaceIds;    // all statespace IDs in order
-  unsigned       size;             // hashtable array size
+  unsigned       size;             // hashtable array size, power of two
+  unsigned       noSymbols;        // number of strings in symbols
+  unsigned       noDeclarations;   // number of entries in declarationTable
 
 public:
    SymbolTable(int size);
@@ -156,6 +162,7 @@ public:
   void   setSSType(Ident, Ident);
 
   Ident  insertFresh(MonaTypeTag t, IdentList *univs = NULL, bool implicit = true);
+  Ident  restoreEntry(char *, MonaTypeTag, IdentList *univs, bool implicit); // formula bundles
 
   void   openLocal();
   void   closeLocal();
@@ -199,6 +206,7 @@ public:
   void        setDefaultRestriction(MonaTypeTag, ASTForm *, Ident);
 
   void        dump(); // dump contents
+  void        print_bucket_statistics();
 
   unsigned  noIdents;       // total number of identifiers
   int       noSS;           // number of state spaces
@@ -19,8 +19,11 @@
 #define _LANGUAGE_C_PLUS_PLUS
 
 // < System Headers >
+#include <cctype>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <fstream>
 #include <new>
 #include <sys/time.h>
@@ -58,6 +61,11 @@
 #include "DecisionProcedure/containers/SymbolicAutomata.h"
 #include "DecisionProcedure/containers/Term.h"
 #include "DecisionProcedure/checkers/SymbolicChecker.h"
+#include "DecisionProcedure/checkers/IncrementalChecker.h"
+#include "DecisionProcedure/utils/FormulaBundle.h"
+#include "DecisionProcedure/utils/Tracer.h"
+#include "DecisionProcedure/utils/MemoryAccounting.h"
+#include "DecisionProcedure/utils/LiveStats.h"
 
 // < Typedefs and usings >
 using std::cout;
@@ -103,10 +111,26 @@ void PrintUsage() {
 		<< " -ga, --print-aut     Print automaton in graphviz\n"
 		<< " -cfX                 Transform all formulae with lesser than X fixpoints into automaton\n"
 		<< " -icfX                Transform all formulae with greater than X fixpoints from the root\n"
+		<< " -cfauto              Decide for each subformula whether to transform it into automaton by its predicted cost\n"
 		<< " -v,  --verify        Will verify the validity of inferred model for unground formulae\n"
 		<< "      --dry-run       Will not run the analysis, only construct automaton\n"
 		<< "      --no-automaton  Don't dump Automaton\n"
 		<< "      --test          Test specified problem [val, sat, unsat]\n"
+		<< "      --timeout=X     Stop the decision procedure after X seconds (result is UNKNOWN)\n"
+		<< "      --mem-limit=X   Stop the decision procedure after using X MB of memory\n"
+		<< "      --step-limit=X  Stop the decision procedure after X steps\n"
+		<< "      --profile       Profile the nodes of automaton (outputs table and INPUT_profile.dot)\n"
+		<< "      --profile=FILE  Profile the nodes of automaton and write the dot with the profile to FILE\n"
+		<< "      --trace=FILE    Write the timeline of the run to FILE as Chrome trace json\n"
+		<< "      --mem-stats     Print the live and peak memory of the subsystems\n"
+		<< "      --mem-snapshots=FILE  Periodically write the memory of the subsystems to FILE\n"
+		<< "      --decide-only   Decide the formula without tracking the (counter)examples\n"
+		<< "      --witness       With --decide-only, replay the search for the found (counter)examples\n"
+		<< "      --incremental   Decide the formula with each of its verify declarations, sharing the automata\n"
+		<< "      --compile       Preprocess the formula into the bundle <filename>.gbundle, that can be decided instead of it\n"
+		<< "      --best-first    Explore the fixpoints (including the search for (counter)examples) by the shortest witness first\n"
+		<< "      --nary-workers=X  Probe the emptiness of the operands of nary intersections in X forked workers\n"
+		<< "      --track-order=X,Y  Assign the first tracks to the variables X, Y, ..., the rest is ordered heuristically\n"
 		<< "      --walk-aut      Does the experiment generating the special dot graph\n"
 		<< "      --serialize     Outputs the preprocessed file\n"
 		<< " -e,  --expand-tagged Expand automata with given tag on first line of formula\n"
@@ -115,6 +139,34 @@ void PrintUsage() {
 		<< "Example: ./gaston -t -d foo.mona\n\n";
 }
 
+/**
+ * Parses the positive numeric value of the limiting option
+ *
+ * @param[in] option:  name of the parsed option
+ * @param[in] value:  parsed value
+ * @param[out] limit:  parsed limit
+ * @param[in] max:  maximal value of the limit
+ * @return: false if the value is not a positive number
+ */
+bool ParseLimit(const char* option, const char* value, unsigned long& limit, unsigned long max) {
+	bool valid = (*value != '\0');
+	for(const char* c = value; *c != '\0'; ++c) {
+		valid = valid && isdigit(*c);
+	}
+	if(valid) {
+		try {
+			limit = std::stoul(std::string(value));
+			valid = (limit > 0 && limit <= max);
+		} catch(std::out_of_range&) {
+			valid = false;
+		}
+	}
+	if(!valid) {
+		std::cerr << "Option '" << option << "' expects positive number up to " << max << ", got '" << value << "'\n";
+	}
+	return valid;
+}
+
 /**
  * Parses input arguments into options
  *
@@ -151,6 +203,12 @@ bool ParseArguments(int argc, char *argv[]) {
 				options.dryRun = true;
 			else if (strcmp(argv[i], "--verify") == 0)
 				options.verifyModels = true;
+			else if (strcmp(argv[i], "--profile") == 0)
+				options.profile = true;
+			else if (strncmp(argv[i], "--profile=", 10) == 0) {
+				options.profile = true;
+				options.profileFile = argv[i] + 10;
+			}
 			else if (strcmp(argv[i], "-ga") == 0 || strcmp(argv[i], "--print-aut") == 0)
 				options.graphvizDAG = true;
 			else if (strcmp(argv[i], "--walk-aut") == 0) {
@@ -160,6 +218,8 @@ bool ParseArguments(int argc, char *argv[]) {
 				options.serializeMona = true;
 			} else if (strcmp(argv[i], "--expand-tagged") == 0)
 				options.expandTagged = true;
+			else if (strcmp(argv[i], "-cfauto") == 0)
+				options.adaptiveFixLimit = true;
 			else if (argv[i][0] == '-' && argv[i][1] == 'c' && argv[i][2] == 'f') {
 				std::string fixLimitStr(argv[i]);
 				fixLimitStr = fixLimitStr.substr(3);
@@ -176,6 +236,39 @@ bool ParseArguments(int argc, char *argv[]) {
 				options.test = TestType::SATISFIABILITY;
 			} else if(strcmp(argv[i], "--test=unsat") == 0) {
 				options.test = TestType::UNSATISFIABILITY;
+			} else if(strncmp(argv[i], "--timeout=", 10) == 0) {
+				unsigned long timeout;
+				if(!ParseLimit("--timeout", argv[i] + 10, timeout, std::numeric_limits<unsigned int>::max()))
+					return false;
+				options.timeout = timeout;
+			} else if(strncmp(argv[i], "--mem-limit=", 12) == 0) {
+				// the limit is converted to kB by the governor
+				if(!ParseLimit("--mem-limit", argv[i] + 12, options.memLimit, std::numeric_limits<size_t>::max() >> 10))
+					return false;
+			} else if(strncmp(argv[i], "--step-limit=", 13) == 0) {
+				if(!ParseLimit("--step-limit", argv[i] + 13, options.stepLimit, std::numeric_limits<unsigned long>::max()))
+					return false;
+			} else if(strncmp(argv[i], "--trace=", 8) == 0) {
+				options.traceFile = argv[i] + 8;
+			} else if(strcmp(argv[i], "--mem-stats") == 0) {
+				options.memStats = true;
+			} else if(strncmp(argv[i], "--mem-snapshots=", 16) == 0) {
+				options.memSnapshots = argv[i] + 16;
+			} else if(strcmp(argv[i], "--decide-only") == 0) {
+				options.decideOnly = true;
+			} else if(strcmp(argv[i], "--witness") == 0) {
+				options.replayWitnesses = true;
+			} else if(strcmp(argv[i], "--incremental") == 0) {
+				options.incremental = true;
+			} else if(strcmp(argv[i], "--compile") == 0) {
+				options.compileBundle = true;
+			} else if(strcmp(argv[i], "--best-first") == 0) {
+				options.bestFirst = true;
+			} else if(strncmp(argv[i], "--nary-workers=", 15) == 0) {
+				if(!ParseLimit("--nary-workers", argv[i] + 15, options.naryWorkers, OPT_NARY_PROBE_MAX_WORKERS))
+					return false;
+			} else if(strncmp(argv[i], "--track-order=", 14) == 0) {
+				options.trackOrder = argv[i] + 14;
 			} else {
 				switch (argv[i][1]) {
 					case 'e':
@@ -207,6 +300,10 @@ bool ParseArguments(int argc, char *argv[]) {
 		std::cerr << "Incorrect combination of '-cfX' and '-icfX' options\n";
 		return false;
 	}
+	if(options.adaptiveFixLimit && (options.inverseFixLimit != -1 || options.fixLimit > 0)) {
+		std::cerr << "Option '-cfauto' cannot be combined with '-cfX' or '-icfX' options\n";
+		return false;
+	}
 	inputFileName = argv[argc-1];
 	return true;
 }
@@ -218,16 +315,82 @@ int main(int argc, char *argv[]) {
 		exit(-1);
 	}
 	initTimer();
+	LiveStats::Install();
+	if(options.traceFile != nullptr) {
+		Tracer::Open(options.traceFile, OPT_TRACE_BUFFER_SIZE);
+		// Fixpoints are not destroyed before the end of the run, so the active ones are traced on closing
+		Tracer::OnClose(TermFixpoint::TraceActive);
+	}
+	if(options.memSnapshots != nullptr) {
+		MemoryAccounting::OpenSnapshots(options.memSnapshots);
+	}
+
+	// Bundles hold the already preprocessed formula
+	bool fromBundle = FormulaBundle::IsBundle(inputFileName);
+	if(fromBundle && (options.incremental || options.compileBundle)) {
+		std::cerr << "[!] Formula bundle cannot be used with '--incremental' or '--compile'\n";
+		exit(-1);
+	}
 
 	timer_gaston.start();
-    Checker *checker = new SymbolicChecker();
-	timer_parse.start();
-    checker->LoadFormulaFromFile();
-	timer_parse.stop();
-	timer_closure.start();
-    checker->CloseUngroundFormula();
-	timer_closure.stop();
-    checker->PreprocessFormula();
+    Checker *checker = (options.incremental ? new IncrementalChecker() : new SymbolicChecker());
+	std::uint64_t traceStart = Tracer::Now();
+	if(fromBundle) {
+		LiveStats::EnterPhase("load");
+		timer_parse.start();
+		if(!checker->LoadFormulaFromBundle()) {
+			delete checker;
+			exit(-1);
+		}
+		timer_parse.stop();
+		Tracer::Complete("load bundle", "phase", traceStart);
+	} else {
+		LiveStats::EnterPhase("parse");
+		timer_parse.start();
+		checker->LoadFormulaFromFile();
+		timer_parse.stop();
+		Tracer::Complete("parse", "phase", traceStart);
+	}
+	if(options.incremental) {
+		// Every check closes and preprocesses its own conjunction of the assertions
+		static_cast<IncrementalChecker*>(checker)->RunVerifyQueries();
+		timer_gaston.stop();
+		std::cout << "\n[*] Total elapsed time: ";
+		timer_gaston.print();
+		delete checker;
+		Tracer::Close();
+		MemoryAccounting::CloseSnapshots();
+		return 0;
+	}
+	if(!fromBundle) {
+		traceStart = Tracer::Now();
+		LiveStats::EnterPhase("closure");
+		timer_closure.start();
+		checker->CloseUngroundFormula();
+		timer_closure.stop();
+		Tracer::Complete("closure", "phase", traceStart);
+		checker->PreprocessFormula();
+	}
+
+	if(options.compileBundle) {
+		// Only the extension of the file name is replaced, dots in the directories are kept
+		std::string bundlePath(inputFileName);
+		size_t nameStart = bundlePath.find_last_of('/');
+		nameStart = (nameStart == std::string::npos ? 0 : nameStart + 1);
+		size_t extension = bundlePath.find_last_of('.');
+		if(extension != std::string::npos && extension > nameStart) {
+			bundlePath.erase(extension);
+		}
+		bundlePath += ".gbundle";
+		bool compiled = checker->CompileFormula(bundlePath.c_str());
+		if(compiled) {
+			std::cout << "[*] Formula compiled into '" << bundlePath << "'\n";
+		}
+		delete checker;
+		Tracer::Close();
+		MemoryAccounting::CloseSnapshots();
+		return (compiled ? 0 : -1);
+	}
 
     if(options.monaWalk) {
         checker->CreateAutomataSizeEstimations();
@@ -246,6 +409,8 @@ int main(int argc, char *argv[]) {
 	timer_gaston.print();
 
     delete checker;
+	Tracer::Close();
+	MemoryAccounting::CloseSnapshots();
 
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  File: Benchmark.h
+ *  Description:
+ *      Minimal runner of micro-benchmarks. Each benchmark is run several
+ *      times for warm-up and then for the measured repetitions, each of
+ *      them doing fixed number of operations. The reported statistics are
+ *      computed over the per-operation times of the repetitions.
+ *****************************************************************************/
+
+#ifndef WSKS_BENCHMARK_H
+#define WSKS_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Prevents the compiler from optimizing away the computation of @p value
+ */
+template<class T>
+inline void DoNotOptimize(T const& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct BenchmarkStats {
+    double min = 0.0;       // < All of the times are in ns per operation
+    double median = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+};
+
+class BenchmarkRunner {
+private:
+    using ClockType = std::chrono::steady_clock;
+
+    size_t _warmup;             // < Number of unmeasured repetitions
+    size_t _repetitions;        // < Number of measured repetitions
+    size_t _ops;                // < Number of operations per repetition
+    const char* _filter;        // < Only benchmarks containing the filter are run
+
+    static double _Percentile(std::vector<double> const& sorted, double p) {
+        size_t idx = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted[(idx == 0 ? 0 : idx - 1)];
+    }
+
+    static BenchmarkStats _ComputeStats(std::vector<double>& samples) {
+        BenchmarkStats stats;
+        std::sort(samples.begin(), samples.end());
+        stats.min = samples.front();
+        stats.median = _Percentile(samples, 0.5);
+        stats.p90 = _Percentile(samples, 0.9);
+        stats.p99 = _Percentile(samples, 0.99);
+        for(auto sample : samples) {
+            stats.mean += sample;
+        }
+        stats.mean /= samples.size();
+        for(auto sample : samples) {
+            stats.stddev += (sample - stats.mean)*(sample - stats.mean);
+        }
+        stats.stddev = std::sqrt(stats.stddev / samples.size());
+        return stats;
+    }
+
+public:
+    BenchmarkRunner(size_t warmup, size_t repetitions, size_t ops, const char* filter)
+        : _warmup(warmup), _repetitions(repetitions), _ops(ops), _filter(filter) {}
+
+    size_t GetOps() const { return this->_ops; }
+
+    static void PrintHeader() {
+        std::cout << std::left << std::setw(44) << "benchmark" << std::right
+                  << std::setw(10) << "min" << std::setw(10) << "median" << std::setw(10) << "p90"
+                  << std::setw(10) << "p99" << std::setw(10) << "mean" << std::setw(10) << "stddev"
+                  << std::setw(8) << "cv%" << "   [ns/op]\n";
+    }
+
+    /**
+     * Runs the benchmark @p name. Before each repetition the @p setup is called (not measured),
+     * then the @p op is called for each of the operations of the repetition.
+     *
+     * @param[in] name:     name of the benchmark
+     * @param[in] setup:    functor called before each repetition
+     * @param[in] op:       functor called with index of the operation
+     */
+    template<class Setup, class Op>
+    void Run(const char* name, Setup setup, Op op) {
+        if(this->_filter != nullptr && strstr(name, this->_filter) == nullptr) {
+            return;
+        }
+
+        std::vector<double> samples;
+        samples.reserve(this->_repetitions);
+        for(size_t rep = 0; rep < this->_warmup + this->_repetitions; ++rep) {
+            setup();
+            auto start = ClockType::now();
+            for(size_t i = 0; i < this->_ops; ++i) {
+                op(i);
+            }
+            auto end = ClockType::now();
+            if(rep >= this->_warmup) {
+                samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / this->_ops);
+            }
+        }
+
+        BenchmarkStats stats = _ComputeStats(samples);
+        std::cout << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << stats.min << std::setw(10) << stats.median << std::setw(10) << stats.p90
+                  << std::setw(10) << stats.p99 << std::setw(10) << stats.mean << std::setw(10) << stats.stddev
+                  << std::setw(8) << (stats.mean == 0.0 ? 0.0 : 100.0*stats.stddev/stats.mean) << "\n";
+    }
+};
+
+#endif //WSKS_BENCHMARK_H
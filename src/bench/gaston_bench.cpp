@@ -0,0 +1,441 @@
+/*****************************************************************************
+ *  gaston - We pay homage to Gaston, an Africa-born brown fur seal who
+ *    escaped the Prague Zoo during the floods in 2002 and made a heroic
+ *    journey for freedom of over 300km all the way to Dresden. There he
+ *    was caught and subsequently died due to exhaustion and infection.
+ *    Rest In Piece, brave soldier.
+ *
+ *  Copyright (c) 2016  Tomas Fiedor <ifiedortom@fit.vutbr.cz>
+ *      Notable mentions:   Ondrej Lengal <ondra.lengal@gmail.com>
+ *                              (author of VATA)
+ *                          Petr Janku <ijanku@fit.vutbr.cz>
+ *                              (MTBDD and automata optimizations)
+ *
+ *  Description:
+ *      Micro-benchmarks of the hot parts of the decision procedure (caches,
+ *      pre of base automata, subsumption, symbol and term workshops). The
+ *      benchmarks run either on synthetic random automaton or on the
+ *      automaton recorded by MONA (exported by 'mona -x').
+ *****************************************************************************/
+
+#define _LANGUAGE_C_PLUS_PLUS
+
+// < System Headers >
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// < MONA Frontend Headers >
+#include "Frontend/bdd.h"
+#include "Frontend/dfa.h"
+#include "Frontend/env.h"
+#include "Frontend/untyped.h"
+#include "Frontend/predlib.h"
+#include "Frontend/ast.h"
+#include "Frontend/code.h"
+#include "Frontend/st_dfa.h"
+#include "Frontend/st_gta.h"
+#include "Frontend/timer.h"
+#include "Frontend/lib.h"
+#include "Frontend/offsets.h"
+#include "Frontend/ident.h"
+#include "Frontend/symboltable.h"
+
+// < dWiNA Headers >
+#include "DecisionProcedure/environment.hh"
+#include "DecisionProcedure/containers/VarToTrackMap.hh"
+#include "DecisionProcedure/containers/SymbolicAutomata.h"
+#include "DecisionProcedure/containers/Term.h"
+#include "DecisionProcedure/containers/Workshops.h"
+#include "bench/Benchmark.h"
+
+// < Global variables >
+Options options;
+MonaUntypedAST *untypedAST;
+SymbolTable symbolTable(1019);
+PredicateLib predicateLib;
+Offsets offsets;
+CodeTable *codeTable;
+Guide guide;
+AutLib lib;
+VarToTrackMap varMap;
+int numTypes = 0;
+bool regenerate = false;
+char *inputFileName = NULL;
+Timer timer_conversion, timer_mona, timer_base, timer_automaton, timer_preprocess, timer_parse, timer_closure;
+Timer timer_gaston;
+
+extern Ident lastPosVar, allPosVar;
+
+void bdd_callback() {
+    throw MonaFailureException();
+}
+
+/**
+ * Base automaton that exposes its mona wrapper, so the pre can be measured without the workshops
+ */
+class BenchAutomaton : public BaseAutomaton {
+public:
+    NEVER_INLINE BenchAutomaton(BaseAutomatonType* aut, size_t vars, Formula_ptr form) : BaseAutomaton(aut, vars, form, false) { }
+    MonaWrapper<size_t>& GetWrapper() { return this->_autWrapper; }
+    virtual void DumpAutomaton() { this->BaseAutDump(); }
+};
+
+struct BenchOptions {
+    size_t warmup = 3;
+    size_t repetitions = 30;
+    size_t ops = 10000;
+    size_t states = 64;
+    size_t tracks = 8;
+    size_t poolSize = 256;
+    unsigned int seed = 42;
+    const char* dfaFile = nullptr;
+    const char* filter = nullptr;
+};
+
+/**
+ * Prints usage of the benchmarks to the standard output.
+ */
+void PrintUsage() {
+    std::cout << "Usage: gaston_bench [options]\n\n"
+        << "Options:\n"
+        << "      --dfa=FILE      Run on automaton recorded by MONA (mona -x) instead of synthetic one\n"
+        << "      --states=X      Number of states of synthetic automaton [64]\n"
+        << "      --tracks=X      Number of tracks of synthetic automaton [8]\n"
+        << "      --warmup=X      Number of unmeasured repetitions [3]\n"
+        << "      --reps=X        Number of measured repetitions [30]\n"
+        << "      --ops=X         Number of operations per repetition [10000]\n"
+        << "      --pool=X        Number of distinct generated inputs [256]\n"
+        << "      --seed=X        Seed of the generator of inputs [42]\n"
+        << "      --filter=STR    Run only benchmarks whose name contains STR\n"
+        << "Example: ./gaston_bench --states=256 --tracks=12 --filter=Pre\n\n";
+}
+
+/**
+ * Parses input arguments into bench options
+ *
+ * @param[in] argc: number of arguments
+ * @param[in] argv: list of arguments
+ * @param[out] opts: parsed options
+ * @return: false if arguments are wrong
+ */
+bool ParseArguments(int argc, char *argv[], BenchOptions& opts) {
+    for(int i = 1; i < argc; ++i) {
+        if(strncmp(argv[i], "--dfa=", 6) == 0) {
+            opts.dfaFile = argv[i] + 6;
+        } else if(strncmp(argv[i], "--states=", 9) == 0) {
+            opts.states = std::stoul(std::string(argv[i] + 9));
+        } else if(strncmp(argv[i], "--tracks=", 9) == 0) {
+            opts.tracks = std::stoul(std::string(argv[i] + 9));
+        } else if(strncmp(argv[i], "--warmup=", 9) == 0) {
+            opts.warmup = std::stoul(std::string(argv[i] + 9));
+        } else if(strncmp(argv[i], "--reps=", 7) == 0) {
+            opts.repetitions = std::stoul(std::string(argv[i] + 7));
+        } else if(strncmp(argv[i], "--ops=", 6) == 0) {
+            opts.ops = std::stoul(std::string(argv[i] + 6));
+        } else if(strncmp(argv[i], "--pool=", 7) == 0) {
+            opts.poolSize = std::stoul(std::string(argv[i] + 7));
+        } else if(strncmp(argv[i], "--seed=", 7) == 0) {
+            opts.seed = std::stoul(std::string(argv[i] + 7));
+        } else if(strncmp(argv[i], "--filter=", 9) == 0) {
+            opts.filter = argv[i] + 9;
+        } else {
+            return false;
+        }
+    }
+    return opts.states > 1 && opts.tracks > 0 && opts.repetitions > 0 && opts.ops > 0 && opts.poolSize > 0;
+}
+
+/**
+ * Initializes the global map of variables to tracks with @p count fresh second-order variables
+ *
+ * @param[in] count: number of tracks
+ * @param[out] idents: identifiers of the created variables
+ */
+void InitializeTracks(size_t count, std::vector<int>& idents) {
+    IdentList vars;
+    for(size_t i = 0; i < count; ++i) {
+        Ident id = symbolTable.insertFresh(MonaTypeTag::Varname2, nullptr, false);
+        idents.push_back(id);
+        vars.push_back(id);
+    }
+    varMap.initializeFromList(&vars);
+}
+
+/**
+ * Generates random automaton with @p states states over the @p indices. The state 0 follows
+ * the convention of MONA and serves only as the pre-initial state leading to the state 1.
+ *
+ * @param[in] states: number of states
+ * @param[in] indices: bdd indices of the tracks
+ * @param[in] gen: generator of random numbers
+ * @return: generated automaton
+ */
+DFA* GenerateAutomaton(size_t states, std::vector<int>& indices, std::mt19937& gen) {
+    const char values[] = {'0', '1', 'X'};
+    std::uniform_int_distribution<size_t> stateDist(1, states - 1);
+    std::uniform_int_distribution<int> valueDist(0, 2);
+    std::uniform_int_distribution<int> exceptionDist(0, 3);
+    std::vector<char> path(indices.size() + 1, '\0');
+    std::string statuses(states, '-');
+
+    dfaSetup(states, indices.size(), indices.data());
+    dfaAllocExceptions(0);
+    dfaStoreState(1);
+    for(size_t s = 1; s < states; ++s) {
+        int exceptions = exceptionDist(gen);
+        dfaAllocExceptions(exceptions);
+        for(int e = 0; e < exceptions; ++e) {
+            for(size_t t = 0; t < indices.size(); ++t) {
+                path[t] = values[valueDist(gen)];
+            }
+            dfaStoreException(stateDist(gen), path.data());
+        }
+        dfaStoreState(stateDist(gen));
+        statuses[s] = (valueDist(gen) == 0 ? '+' : '-');
+    }
+    statuses[0] = '0';
+    return dfaBuild(&statuses[0]);
+}
+
+/**
+ * Loads automaton recorded by MONA and renames its indices to freshly created tracks
+ *
+ * @param[in] filename: name of the file with exported automaton
+ * @param[out] tracks: number of tracks of the automaton
+ * @return: loaded automaton or nullptr if the file could not be read
+ */
+DFA* ImportAutomaton(const char* filename, size_t& tracks) {
+    char **names;
+    int *orders;
+    DFA* dfa = dfaImport(const_cast<char*>(filename), &names, &orders);
+    if(dfa == nullptr) {
+        return nullptr;
+    }
+
+    for(tracks = 0; names[tracks] != nullptr; ++tracks);
+    std::vector<int> idents;
+    InitializeTracks(tracks, idents);
+    dfaReplaceIndices(dfa, idents.data());
+    return dfa;
+}
+
+/**
+ * Creates random symbol over all of the tracks
+ */
+Symbol* GenerateSymbol(SymbolWorkshop& workshop, size_t tracks, std::mt19937& gen) {
+    const char values[] = {'0', '1', 'X'};
+    std::uniform_int_distribution<int> valueDist(0, 2);
+    Symbol* symbol = SymbolWorkshop::CreateZeroSymbol();
+    for(size_t t = 0; t < tracks; ++t) {
+        symbol = workshop.CreateSymbol(symbol, t, values[valueDist(gen)]);
+    }
+    return symbol;
+}
+
+/**
+ * Creates random nonempty subset of @p states of size at most @p maxSize
+ */
+BaseAutomatonStateSet GenerateStateSet(std::vector<size_t> const& states, size_t maxSize, std::mt19937& gen) {
+    std::uniform_int_distribution<size_t> sizeDist(1, std::min(maxSize, states.size()));
+    std::uniform_int_distribution<size_t> stateDist(0, states.size() - 1);
+    BaseAutomatonStateSet set;
+    for(size_t i = 0, size = sizeDist(gen); i < size; ++i) {
+        set.insert(states[stateDist(gen)]);
+    }
+    return set;
+}
+
+/**
+ * Collects the states of @p aut reachable by pre from its final states through @p symbols
+ */
+void CollectStates(BenchAutomaton* aut, std::vector<Symbol*> const& symbols, std::vector<size_t>& states) {
+    BaseAutomatonStateSet reached = reinterpret_cast<TermBaseSet*>(aut->GetFinalStates())->states;
+    BaseAutomatonStateSet frontier = reached;
+    while(!frontier.empty()) {
+        BaseAutomatonStateSet next;
+        for(auto symbol : symbols) {
+            BaseAutomatonStateSet pre = aut->GetWrapper().Pre(frontier, symbol->GetTrackMask());
+            for(auto state : pre) {
+                if(reached.find(state) == reached.end()) {
+                    next.insert(state);
+                }
+            }
+        }
+        reached.insert(next);
+        frontier = next;
+    }
+    states.assign(reached.begin(), reached.end());
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions opts;
+    if(!ParseArguments(argc, argv, opts)) {
+        PrintUsage();
+        exit(-1);
+    }
+    initTimer();
+    lastPosVar = -1;
+    allPosVar = -1;
+
+    std::mt19937 gen(opts.seed);
+    DFA* dfa;
+    if(opts.dfaFile != nullptr) {
+        dfa = ImportAutomaton(opts.dfaFile, opts.tracks);
+        if(dfa == nullptr) {
+            std::cerr << "[!] Could not import automaton from '" << opts.dfaFile << "'\n";
+            exit(-1);
+        }
+    } else {
+        std::vector<int> indices;
+        InitializeTracks(opts.tracks, indices);
+        dfa = GenerateAutomaton(opts.states, indices, gen);
+    }
+
+    BenchAutomaton* aut = new BenchAutomaton(dfa, varMap.TrackLength(), new ASTForm_True(Pos()));
+    aut->IncReferences();
+
+    // Generate the pools of inputs
+    std::vector<Symbol*> symbols;
+    for(size_t i = 0; i < opts.poolSize; ++i) {
+        symbols.push_back(GenerateSymbol(aut->symbolFactory, opts.tracks, gen));
+    }
+    std::vector<size_t> states;
+    CollectStates(aut, symbols, states);
+    if(states.empty()) {
+        std::cerr << "[!] Automaton has no states reachable from final states\n";
+        exit(-1);
+    }
+
+    std::vector<BaseAutomatonStateSet> sets;
+    std::vector<Term_ptr> baseSets;
+    std::vector<Term_ptr> products;
+    for(size_t i = 0; i < opts.poolSize; ++i) {
+        sets.push_back(GenerateStateSet(states, 8, gen));
+        baseSets.push_back(aut->_factory.CreateBaseSet(BaseAutomatonStateSet(sets.back())));
+    }
+    std::uniform_int_distribution<size_t> poolDist(0, opts.poolSize - 1);
+    for(size_t i = 0; i < opts.poolSize; ++i) {
+        products.push_back(aut->_factory.CreateProduct(baseSets[poolDist(gen)], baseSets[poolDist(gen)], ProductType::INTERSECTION));
+    }
+    std::vector<std::pair<size_t, size_t>> pairs;
+    for(size_t i = 0; i < opts.ops; ++i) {
+        pairs.push_back(std::make_pair(poolDist(gen), poolDist(gen)));
+    }
+
+    // Trimming removes the random half of tracks, remapping rotates the tracks by one
+    Gaston::VarList trimmed;
+    std::map<unsigned int, unsigned int>* remap = new std::map<unsigned int, unsigned int>();
+    for(size_t t = 0; t < opts.tracks; ++t) {
+        if(gen() % 2) {
+            trimmed.insert(t);
+        }
+        (*remap)[t] = (t + 1) % opts.tracks;
+    }
+
+    std::cout << "[*] Benchmarking automaton with " << dfa->ns << " states over " << opts.tracks << " tracks ("
+              << states.size() << " reachable states, pool of " << opts.poolSize << " inputs)\n";
+    std::cout << "[*] " << opts.warmup << " warm-up and " << opts.repetitions << " measured repetitions of "
+              << opts.ops << " operations\n\n";
+
+    BenchmarkRunner runner(opts.warmup, opts.repetitions, opts.ops, opts.filter);
+    BenchmarkRunner::PrintHeader();
+
+    std::unique_ptr<ResultCache> cache;
+    runner.Run("BinaryCache::StoreIn",
+        [&]() { cache.reset(new ResultCache()); },
+        [&](size_t i) {
+            cache->StoreIn(std::make_pair(baseSets[pairs[i].first], symbols[pairs[i].second]), std::make_pair(baseSets[i % opts.poolSize], true));
+        });
+    runner.Run("BinaryCache::retrieveFromCache",
+        [&]() {
+            cache.reset(new ResultCache());
+            for(size_t i = 0; i < opts.poolSize; ++i) {
+                cache->StoreIn(std::make_pair(baseSets[i], symbols[i]), std::make_pair(baseSets[i], true));
+            }
+        },
+        [&](size_t i) {
+            ResultType result;
+            DoNotOptimize(cache->retrieveFromCache(std::make_pair(baseSets[pairs[i].first], symbols[pairs[i].second]), result));
+        });
+
+    runner.Run("MonaWrapper::Pre",
+        []() {},
+        [&](size_t i) {
+            DoNotOptimize(aut->GetWrapper().Pre(sets[pairs[i].first], symbols[pairs[i].second]->GetTrackMask()));
+        });
+    runner.Run("BaseAutomaton::Pre",
+        []() {},
+        [&](size_t i) {
+            DoNotOptimize(aut->Pre(symbols[pairs[i].second], baseSets[pairs[i].first], false));
+        });
+
+    runner.Run("TermBaseSet::IsSubsumed",
+        [&]() { aut->_subCache.clear(); },
+        [&](size_t i) {
+            DoNotOptimize(baseSets[pairs[i].first]->IsSubsumed(baseSets[pairs[i].second], OPT_PARTIALLY_LIMITED_SUBSUMPTION));
+        });
+    runner.Run("TermWorkshop::CreateUnionBaseSet",
+        []() {},
+        [&](size_t i) {
+            DoNotOptimize(aut->_factory.CreateUnionBaseSet(baseSets[pairs[i].first], baseSets[pairs[i].second]));
+        });
+    runner.Run("TermProduct::IsSubsumed",
+        [&]() { aut->_subCache.clear(); },
+        [&](size_t i) {
+            DoNotOptimize(products[pairs[i].first]->IsSubsumed(products[pairs[i].second], OPT_PARTIALLY_LIMITED_SUBSUMPTION));
+        });
+
+    runner.Run("SymbolWorkshop::CreateTrimmedSymbol",
+        []() {},
+        [&](size_t i) {
+            DoNotOptimize(aut->symbolFactory.CreateTrimmedSymbol(symbols[pairs[i].first], &trimmed));
+        });
+    runner.Run("SymbolWorkshop::CreateRemappedSymbol",
+        []() {},
+        [&](size_t i) {
+            DoNotOptimize(aut->symbolFactory.CreateRemappedSymbol(symbols[pairs[i].first], remap, 1));
+        });
+
+    // Note: the workshop cannot be destroyed, as it deletes the shared empty terms, so one workshop is
+    //   reused for the missing keys and its terms are destroyed before each of the repetitions.
+    Workshops::TermWorkshop* workshop = new Workshops::TermWorkshop(aut);
+    workshop->InitializeWorkshop();
+    runner.Run("TermWorkshop::CreateBaseSet (hit)",
+        []() {},
+        [&](size_t i) {
+            DoNotOptimize(aut->_factory.CreateBaseSet(BaseAutomatonStateSet(sets[pairs[i].first])));
+        });
+    // Each operation creates distinct subset of the reachable states, encoded by the bits of its index
+    std::vector<BaseAutomatonStateSet> missingSets;
+    size_t subsets = (states.size() >= 63 ? ~static_cast<size_t>(0) : (static_cast<size_t>(1) << states.size()) - 1);
+    for(size_t i = 0; i < opts.ops; ++i) {
+        BaseAutomatonStateSet set;
+        size_t bits = i % subsets + 1;
+        for(size_t b = 0; bits != 0; ++b, bits >>= 1) {
+            if(bits & 1) {
+                set.insert(states[b]);
+            }
+        }
+        missingSets.push_back(set);
+    }
+    runner.Run("TermWorkshop::CreateBaseSet (miss)",
+        [&]() {
+            std::vector<Term*> dead;
+            workshop->PurgeDead(std::unordered_set<Term*>(), dead);
+            for(Term* term : dead) {
+                Workshops::TermWorkshop::DestroyTerm(term);
+            }
+        },
+        [&](size_t i) {
+            DoNotOptimize(workshop->CreateBaseSet(BaseAutomatonStateSet(missingSets[i])));
+        });
+
+    return 0;
+}
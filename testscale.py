@@ -0,0 +1,294 @@
+'''
+    WSkS Scaling Bench
+
+    @author: Tomas Fiedor, ifiedortom@fit.vutbr.cz
+    @summary: Measures how gaston scales along the parametrized families of testgen.py and
+      fits the growth curve of each measure, so the regressions in scaling can be detected
+
+'''
+
+from __future__ import print_function
+
+import argparse
+import json
+import math
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+import testgen
+from termcolor import colored
+
+timeout_error = -2
+gaston_error = -1
+no_error = 0
+
+# measures parsed from the output of gaston, time and memory are measured by the harness
+measures = {
+    'terms': "overall state space: ([0-9]+)",
+    'fixpoint': "explored fixpoint space: ([0-9]+)",
+    'fixpoints': "term fixpoints: ([0-9]+)",
+}
+scaled_measures = ['time', 'memory', 'terms', 'fixpoint']
+
+
+def create_argument_parser():
+    '''
+    Creates Argument Parser object
+    '''
+    parser = argparse.ArgumentParser("WSkS Scaling Bench")
+    parser.add_argument('--family', '-f', action='append', default=None,
+                        help='family of testgen.py to measure (horn_sub, horn_trans, set_singletons, veanes, ...)')
+    parser.add_argument('--alts', '-a', type=int, default=0, help='number of alternations of the family')
+    parser.add_argument('--up-to', '-n', type=int, default=10, help='measures the family for N = 1..UP_TO')
+    parser.add_argument('--bin', '-b', default=os.path.join(os.curdir, 'build', 'gaston'), help='gaston binary')
+    parser.add_argument('--timeout', '-t', type=int, default=60, help='timeout of one run in seconds')
+    parser.add_argument('--repeat', '-r', type=int, default=3, help='number of runs for each N (the fastest is taken)')
+    parser.add_argument('--min-time', type=float, default=0.05, help='runs faster than MIN_TIME seconds are not fitted')
+    parser.add_argument('--tolerance', type=float, default=0.25, help='relative tolerance of the growth parameter')
+    parser.add_argument('--baseline', default=None, help='json with fitted curves the results are compared to')
+    parser.add_argument('--save-baseline', default=None, help='saves the fitted curves as json baseline')
+    parser.add_argument('--csv-name', '-c', default=None, help='exports the measured data to csv')
+    parser.add_argument('--gaston-params', '-gp', action='append', default=[], help='feeds additional params to gaston')
+    return parser
+
+
+def get_generator(family, alts):
+    '''
+    Finds the generator of the family in testgen.py the same way as testgen.py does
+
+    @param family: name of the family
+    @param alts: number of alternations (0 = family without alternations)
+    @return: function taking parameter n and returning the formula or None
+    '''
+    method_name = "generate_" + family
+    if alts != 0 and family != "veanes":
+        method_name += "_even_alts" if alts % 2 == 0 else "_odd_alts"
+    generator = getattr(testgen, method_name)
+    if alts == 0 and family != "veanes":
+        return generator
+    else:
+        return lambda n: generator(n, alts)
+
+
+def run_gaston(options, formula_file):
+    '''
+    Runs gaston on the @p formula_file and measures its wall time and peak memory
+
+    @param options: options of the bench
+    @param formula_file: file with the formula
+    @return: (error code, dictionary of measures)
+    '''
+    # gaston checks its timeout cooperatively, the hard timeout guards the parts that are not governed
+    args = ['timeout', '{}s'.format(2*options.timeout), options.bin, '--no-automaton', '--timeout={}'.format(options.timeout)] + options.gaston_params + [formula_file]
+    with tempfile.TemporaryFile() as output_file:
+        start = time.time()
+        proc = subprocess.Popen(args, stdout=output_file, stderr=subprocess.STDOUT)
+        # the process is reaped by wait4, so we get the rusage of this very run
+        _, status, usage = os.wait4(proc.pid, 0)
+        elapsed = time.time() - start
+        proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+        output_file.seek(0)
+        output = output_file.read().decode('utf-8', 'replace').lower()
+
+    if proc.returncode == 124 or re.search("formula is [^']*'unknown'", output) is not None:
+        return timeout_error, {}
+    elif proc.returncode != 0:
+        return gaston_error, {}
+
+    data = {'time': elapsed, 'memory': usage.ru_maxrss}
+    for (name, regex) in measures.items():
+        match = re.search(regex, output)
+        data[name] = int(match.group(1)) if match is not None else 0
+    return no_error, data
+
+
+def linear_regression(xs, ys):
+    '''
+    Fits ys = a + b*xs by the least squares
+
+    @return: (a, b, r2)
+    '''
+    n = float(len(xs))
+    mean_x = sum(xs) / n
+    mean_y = sum(ys) / n
+    sxx = sum((x - mean_x)**2 for x in xs)
+    sxy = sum((x - mean_x)*(y - mean_y) for (x, y) in zip(xs, ys))
+    syy = sum((y - mean_y)**2 for y in ys)
+    b = sxy / sxx if sxx != 0 else 0.0
+    a = mean_y - b*mean_x
+    r2 = (sxy*sxy) / (sxx*syy) if sxx != 0 and syy != 0 else 1.0
+    return a, b, r2
+
+
+def fit_growth(points):
+    '''
+    Fits the growth curve of the measured @p points, both as the polynomial y = c*n^d
+    (linear in log-log scale) and as the exponential y = c*b^n (linear in semi-log scale)
+    and returns the one that fits better.
+
+    @param points: list of (n, y) with y > 0
+    @return: dictionary with model, growth parameter and r2, or None if there is too few points
+    '''
+    points = [(n, y) for (n, y) in points if y > 0]
+    if len(points) < 3:
+        return None
+    log_n = [math.log(n) for (n, _) in points]
+    lin_n = [float(n) for (n, _) in points]
+    log_y = [math.log(y) for (_, y) in points]
+
+    _, degree, poly_r2 = linear_regression(log_n, log_y)
+    _, log_base, exp_r2 = linear_regression(lin_n, log_y)
+    if exp_r2 > poly_r2:
+        return {'model': 'exponential', 'param': math.exp(log_base), 'r2': exp_r2}
+    else:
+        return {'model': 'polynomial', 'param': degree, 'r2': poly_r2}
+
+
+def format_growth(fit):
+    '''
+    @return: human readable growth curve
+    '''
+    if fit is None:
+        return "n/a"
+    elif fit['model'] == 'polynomial':
+        return "O(n^{:.2f}) [r2 = {:.3f}]".format(fit['param'], fit['r2'])
+    else:
+        return "O({:.2f}^n) [r2 = {:.3f}]".format(fit['param'], fit['r2'])
+
+
+def is_regression(fit, base_fit, tolerance):
+    '''
+    Checks whether the @p fit grows faster than the @p base_fit. Exponential growth is always
+    worse than the polynomial one, otherwise the degree (or the logarithm of the base) is compared.
+
+    @return: true if the scaling regressed
+    '''
+    if fit is None or base_fit is None:
+        return False
+    if fit['model'] != base_fit['model']:
+        return fit['model'] == 'exponential'
+    if fit['model'] == 'polynomial':
+        return fit['param'] > base_fit['param']*(1 + tolerance) + 0.1
+    else:
+        return math.log(fit['param']) > math.log(base_fit['param'])*(1 + tolerance) + 0.01
+
+
+def measure_family(options, family, workdir):
+    '''
+    Generates the family for N = 1..up_to and measures each of them. The measuring of the family
+    stops at the first timeout, as the bigger instances would time out as well.
+
+    @return: list of (n, data)
+    '''
+    generator = get_generator(family, options.alts)
+    results = []
+    for n in range(1, options.up_to + 1):
+        formula = generator(n)
+        if formula is None:
+            continue
+        formula_file = os.path.join(workdir, "{}{:02}.mona".format(family, n))
+        with open(formula_file, 'w') as file:
+            file.write(formula)
+
+        best = None
+        for _ in range(options.repeat):
+            ret, data = run_gaston(options, formula_file)
+            if ret != no_error:
+                break
+            if best is None:
+                best = data
+            else:
+                best['time'] = min(best['time'], data['time'])
+                best['memory'] = min(best['memory'], data['memory'])
+
+        if ret != no_error:
+            print("[!] {} n = {}: {}".format(family, n, colored("timeout", "yellow") if ret == timeout_error else colored("error", "red")))
+            break
+        print("[*] {} n = {}: {:.2f}s, {}kB, {} terms, {} fixpoint space".format(
+            family, n, best['time'], best['memory'], best['terms'], best['fixpoint']))
+        results.append((n, best))
+    return results
+
+
+def fit_family(options, results):
+    '''
+    Fits the growth curves of all of the scaled measures of the family
+
+    @return: dictionary measure -> fit
+    '''
+    fits = {}
+    for measure in scaled_measures:
+        if measure == 'time':
+            points = [(n, data[measure]) for (n, data) in results if data[measure] >= options.min_time]
+        else:
+            points = [(n, data[measure]) for (n, data) in results]
+        fits[measure] = fit_growth(points)
+    return fits
+
+
+def export_to_csv(options, all_results):
+    '''
+    Exports the measured data of all families to csv
+    '''
+    with open(options.csv_name, 'w') as csv_file:
+        csv_file.write("family, n, " + ", ".join(scaled_measures + ['fixpoints']) + "\n")
+        for (family, results) in sorted(all_results.items()):
+            for (n, data) in results:
+                csv_file.write("{}, {}, ".format(family, n) + ", ".join(str(data[m]) for m in scaled_measures + ['fixpoints']) + "\n")
+
+
+if __name__ == '__main__':
+    print("[*] WSkS Scaling Bench")
+    print("[c] Tomas Fiedor, ifiedortom@fit.vutbr.cz")
+
+    options = create_argument_parser().parse_args()
+    families = options.family if options.family is not None else ['horn_sub', 'horn_trans', 'set_singletons', 'veanes']
+    baseline = {}
+    if options.baseline is not None:
+        with open(options.baseline, 'r') as baseline_file:
+            baseline = json.load(baseline_file)
+
+    workdir = tempfile.mkdtemp(prefix='gaston_scale')
+    all_results = {}
+    all_fits = {}
+    regressions = []
+    try:
+        for family in families:
+            name = family + ("_{}alts".format(options.alts) if options.alts != 0 else "")
+            try:
+                results = measure_family(options, family, workdir)
+            except AttributeError:
+                print("[!] No benchmark template for '{}'".format(family))
+                continue
+            all_results[name] = results
+            all_fits[name] = fit_family(options, results)
+
+            print("[*] Growth of '{}':".format(name))
+            for measure in scaled_measures:
+                fit = all_fits[name][measure]
+                base_fit = baseline.get(name, {}).get(measure)
+                line = "\t{:10} {}".format(measure, format_growth(fit))
+                if base_fit is not None:
+                    line += " (baseline {})".format(format_growth(base_fit))
+                    if is_regression(fit, base_fit, options.tolerance):
+                        regressions.append((name, measure))
+                        line += " " + colored("REGRESSION", "red")
+                print(line)
+    finally:
+        shutil.rmtree(workdir)
+
+    if options.csv_name is not None:
+        export_to_csv(options, all_results)
+    if options.save_baseline is not None:
+        with open(options.save_baseline, 'w') as baseline_file:
+            json.dump(all_fits, baseline_file, indent=2, sort_keys=True)
+
+    if regressions:
+        print("[!] Scaling regressed in: " + ", ".join("{}/{}".format(f, m) for (f, m) in regressions))
+        sys.exit(1)
+    print("[*] No regression in scaling")